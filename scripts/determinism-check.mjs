@@ -0,0 +1,57 @@
+/**
+ * Run src/debug/DeterminismCheck.ts in Node against a golden file
+ * Vite loads the TypeScript module (no separate TS runner needed); the
+ * cubiomes build is loaded from public/, so build it first (wasm/build.sh).
+ *
+ * Usage: npm run check:determinism [-- check|record [golden file] [kind...]]
+ *        The golden file defaults to wasm/native/golden.txt. "record" writes
+ *        every digest the JS side computes, replacing the file; with kinds it
+ *        replaces only those kinds' lines (e.g. "record wasm/native/golden.txt
+ *        chunkdata"). Record "biomes" natively (golden record), which uses
+ *        plain genBiomes rather than the wrapper's fast paths.
+ */
+
+import { readFile, writeFile } from 'node:fs/promises';
+import { createServer } from 'vite';
+
+const [mode = 'check', path = 'wasm/native/golden.txt', ...kinds] = process.argv.slice(2);
+if ((mode !== 'check' && mode !== 'record') || (mode === 'check' && kinds.length > 0)) {
+  console.error('Usage: determinism-check.mjs check [golden file] | record [golden file] [kind...]');
+  process.exit(2);
+}
+
+const server = await createServer({
+  server: { middlewareMode: true },
+  appType: 'custom',
+  logLevel: 'error',
+});
+
+let status = 0;
+try {
+  const check = await server.ssrLoadModule('/src/debug/DeterminismCheck.ts');
+
+  if (mode === 'record') {
+    let lines = await check.computeDigests();
+    let kept = [];
+    if (kinds.length > 0) {
+      // Keep comments and every other kind's lines as they are
+      const existing = await readFile(path, 'utf8').catch(() => '');
+      kept = existing.split('\n').filter((line) =>
+        line !== '' && (line.startsWith('#') || !kinds.includes(check.digestKind(line))));
+      lines = lines.filter((line) => kinds.includes(check.digestKind(line)));
+    }
+    await writeFile(path, `${[...kept, ...lines].join('\n')}\n`);
+    console.log(`Recorded ${lines.length} digests to ${path}`);
+  } else {
+    const golden = await readFile(path, 'utf8').catch(() => null);
+    if (golden === null) {
+      console.error(`No golden file at ${path}`);
+      status = 2;
+    } else {
+      status = (await check.runDeterminismCheck(golden)) ? 0 : 1;
+    }
+  }
+} finally {
+  await server.close();
+}
+process.exit(status);
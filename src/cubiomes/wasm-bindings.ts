@@ -5,10 +5,56 @@
 
 // Type definitions for the Emscripten module
 interface CubiomesModule {
+  _create_generator(mc_version: number, flags: number): number;
+  _destroy_generator(handle: number): void;
+  _generator_apply_seed(handle: number, seed_hi: number, seed_lo: number, dim: number): void;
+  _generator_configure(handle: number, mc_version: number, flags: number, seed_hi: number, seed_lo: number, dim: number): number;
+  _generator_snapshot_size(): number;
+  _generator_snapshot(handle: number, out: number): number;
+  _generator_restore(handle: number, snapshot: number): number;
+  _generator_seed_hi(handle: number): number;
+  _generator_seed_lo(handle: number): number;
+  _generator_dim(handle: number): number;
+  _generator_get_biome_at(handle: number, scale: number, x: number, y: number, z: number): number;
+  _generator_point_buffer(handle: number, n: number): number;
+  _get_biomes_at_points(handle: number, scale: number, xs: number, ys: number, zs: number, n: number, out: number): number;
+  _get_spawn_table(handle: number): number;
+  _find_spawn(handle: number, max_radius: number, out: number): number;
+  _get_tree_table(handle: number): number;
+  _get_tree_surface(handle: number): number;
+  _gen_chunk_trees(handle: number, cx: number, cz: number): number;
+  _get_tree_templates(): number;
+  _create_voxel_store(): number;
+  _destroy_voxel_store(store: number): void;
+  _voxel_get(store: number, x: number, y: number, z: number): number;
+  _voxel_set(store: number, x: number, y: number, z: number, value: number): number;
+  _voxel_fill(store: number, x0: number, y0: number, z0: number, x1: number, y1: number, z1: number, value: number): number;
+  _voxel_column_top(store: number, x: number, z: number, ignore: number): number;
+  _voxel_chunk_blocks(store: number, cx: number, cz: number, ignore: number): number;
+  _generator_cache_hits(handle: number): number;
+  _generator_cache_misses(handle: number): number;
+  _generator_gen_biomes_2d(handle: number, scale: number, x: number, z: number, sx: number, sz: number, y: number): number;
+  _generator_gen_biomes_2d_u8(handle: number, scale: number, x: number, z: number, sx: number, sz: number, y: number): number;
+  _biome_pyramid_size(x: number, z: number, w: number, h: number, levels: number): number;
+  _gen_biome_pyramid(handle: number, x: number, z: number, w: number, h: number, levels: number, out: number): number;
+  _get_render_palette(handle: number): number;
+  _render_biome_rgba(handle: number, scale: number, x: number, z: number, w: number, h: number, palette: number, flags: number, out: number): number;
+  _gen_chunk_biomes_halo(handle: number, cx: number, cz: number, halo: number): number;
+  _gen_region_biomes(handle: number, cx0: number, cz0: number, ncx: number, ncz: number, halo: number): number;
+  _get_surface_table(handle: number): number;
+  _configure_surface(handle: number, seed: number): void;
+  _start_chunk_workers(handle: number, threads: number): number;
+  _stop_chunk_workers(handle: number): void;
+  _submit_chunk(handle: number, cx: number, cz: number): number;
+  _poll_completed(handle: number): number;
+  _gen_noise_grid(handle: number, noise: number, x0: number, z0: number, nx: number, nz: number, scale: number): number;
+  _gen_chunk_surface(handle: number, cx: number, cz: number): number;
+  _gen_region_surfaces(handle: number, cx0: number, cz0: number, ncx: number, ncz: number): number;
   _init_generator(mc_version: number, flags: number): void;
   _apply_seed(seed_hi: number, seed_lo: number, dim: number): void;
   _get_biome_at(scale: number, x: number, y: number, z: number): number;
   _gen_biomes_2d(buffer: number, scale: number, x: number, z: number, sx: number, sz: number, y: number): number;
+  _gen_biomes_2d_view(scale: number, x: number, z: number, sx: number, sz: number, y: number): number;
   _alloc_biome_buffer(sx: number, sz: number): number;
   _free_buffer(buffer: number): void;
   _get_mc_version(major: number, minor: number): number;
@@ -18,6 +64,7 @@ interface CubiomesModule {
   _get_biome_base_height(biome_id: number): number;
   _biome_has_trees(biome_id: number): number;
   _get_biome_grass_color(biome_id: number): number;
+  _get_biome_meta_table(): number;
   _malloc(size: number): number;
   _free(ptr: number): void;
   
@@ -26,48 +73,119 @@ interface CubiomesModule {
   getValue: (ptr: number, type: string) => number;
   setValue: (ptr: number, value: number, type: string) => void;
   HEAP32: Int32Array;
+  HEAPU8: Uint8Array;
+  HEAPF64: Float64Array;
 }
 
 // Global module instance
 let module: CubiomesModule | null = null;
 let moduleLoading: Promise<CubiomesModule> | null = null;
+let moduleVariant: CubiomesBuildVariant | null = null;
+let biomeMeta: BiomeMetaTable | null = null;
+let treeTemplates: TreeTemplates | null = null;
+
+/**
+ * WASM build variants (see wasm/build.sh), best first
+ */
+export type CubiomesBuildVariant = 'simd128-threads' | 'simd128' | 'baseline';
+
+const VARIANT_ORDER: CubiomesBuildVariant[] = ['simd128-threads', 'simd128', 'baseline'];
+
+const VARIANT_SCRIPTS: Record<CubiomesBuildVariant, string> = {
+  'simd128-threads': 'cubiomes-threads.js',
+  simd128: 'cubiomes-simd.js',
+  baseline: 'cubiomes.js',
+};
+
+// Where the cubiomes*.js/.wasm files are served from (see setCubiomesBaseUrl)
+let baseUrl: string | null = null;
+
+/**
+ * Override where the cubiomes build files are loaded from
+ * Must be called before the module is loaded. Defaults to '/' (Vite serves
+ * public/ at the site root) in browsers and workers, and to the public/
+ * directory under the working directory in Node.
+ */
+export function setCubiomesBaseUrl(url: string): void {
+  baseUrl = url.endsWith('/') ? url : `${url}/`;
+}
+
+function getBaseUrl(): string {
+  if (baseUrl) return baseUrl;
+  
+  // eslint-disable-next-line @typescript-eslint/no-explicit-any
+  const proc = (globalThis as any).process;
+  if (proc?.versions?.node) {
+    const cwd = (proc.cwd() as string).replace(/\\/g, '/');
+    return `file://${cwd.startsWith('/') ? '' : '/'}${cwd}/public/`;
+  }
+  return '/';
+}
+
+// Tiny module that uses a simd128 instruction:
+// WebAssembly.validate only accepts it on hosts that support the feature
+const SIMD_PROBE = new Uint8Array([
+  0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+/**
+ * Pick the best build variant this host can run
+ * @param allowThreads - Consider the threaded build (off inside our own workers,
+ *                       which generate on their own thread already)
+ */
+export function detectCubiomesVariant(allowThreads = true): CubiomesBuildVariant {
+  if (typeof WebAssembly === 'undefined' || !WebAssembly.validate(SIMD_PROBE)) {
+    return 'baseline';
+  }
+  // Shared wasm memory needs SharedArrayBuffer, which needs cross-origin isolation
+  // (never set in Node, which therefore always gets a single-threaded build)
+  if (allowThreads && typeof SharedArrayBuffer !== 'undefined' && globalThis.crossOriginIsolated) {
+    return 'simd128-threads';
+  }
+  return 'simd128';
+}
+
+/**
+ * Build variant that was actually loaded (null until the module is loaded)
+ */
+export function getCubiomesVariant(): CubiomesBuildVariant | null {
+  return moduleVariant;
+}
 
 /**
  * Load the cubiomes WASM module
+ * The builds are ES modules, so this works on the main thread, in module
+ * workers and in Node (benchmarks, headless tests) alike. Picks the best variant the host supports and falls
+ * back to the next one down if that variant's files are missing.
  */
-export async function loadCubiomesModule(): Promise<CubiomesModule> {
+export async function loadCubiomesModule(allowThreads = true): Promise<CubiomesModule> {
   if (module) return module;
   
   if (moduleLoading) return moduleLoading;
   
   moduleLoading = (async () => {
-    // Load the WASM module using script injection (Vite-compatible)
-    // The cubiomes.js file creates a global CubiomesModule factory
-    await new Promise<void>((resolve, reject) => {
-      // Check if already loaded
-      // eslint-disable-next-line @typescript-eslint/no-explicit-any
-      if ((window as any).CubiomesModule) {
-        resolve();
-        return;
+    const candidates = VARIANT_ORDER.slice(VARIANT_ORDER.indexOf(detectCubiomesVariant(allowThreads)));
+    
+    for (const variant of candidates) {
+      let factory: (() => Promise<CubiomesModule>) | undefined;
+      try {
+        // Served from public/ at runtime, so keep the bundler's hands off it
+        const url = getBaseUrl() + VARIANT_SCRIPTS[variant];
+        factory = (await import(/* @vite-ignore */ url)).default;
+      } catch {
+        continue;
       }
       
-      const script = document.createElement('script');
-      script.src = '/cubiomes.js';
-      script.onload = () => resolve();
-      script.onerror = () => reject(new Error('Failed to load cubiomes.js'));
-      document.head.appendChild(script);
-    });
-    
-    // Get the factory function and create the module
-    // eslint-disable-next-line @typescript-eslint/no-explicit-any
-    const CubiomesModuleFactory = (window as any).CubiomesModule as () => Promise<CubiomesModule>;
-    if (!CubiomesModuleFactory) {
-      throw new Error('CubiomesModule not found in window');
-    }
-    
-    module = await CubiomesModuleFactory();
-    console.log('✅ Cubiomes WASM module loaded');
-    return module;
+      if (!factory) continue;
+      module = await factory();
+      moduleVariant = variant;
+      biomeMeta = readBiomeMetaTable(module);
+      treeTemplates = readTreeTemplates(module);
+      console.log(`✅ Cubiomes WASM module loaded (${variant})`);
+      return module;
+    }
+    
+    throw new Error('Failed to load cubiomes.js');
   })();
   
   return moduleLoading;
@@ -80,6 +198,16 @@ export function isModuleLoaded(): boolean {
   return module !== null;
 }
 
+/**
+ * Map a Minecraft release (1.minor) to the native cubiomes version enum.
+ * MCVersion values are passed through raw elsewhere; use this when output
+ * must match native tools (wasm/native) bit for bit.
+ */
+export function getNativeMcVersion(minor: number): number {
+  if (!module) throw new Error('Cubiomes module not loaded');
+  return module._get_mc_version(1, minor);
+}
+
 /**
  * Minecraft version constants
  */
@@ -105,15 +233,340 @@ export const Dimension = {
   END: 1,
 } as const;
 
+/**
+ * Dimension type
+ */
+export type DimensionType = typeof Dimension[keyof typeof Dimension];
+
+/**
+ * Surface table marker: swamp column, water or grass depending on the patch noise
+ */
+export const SURFACE_SWAMP = 0xFF;
+
+/**
+ * 8-bit biome outputs store cubiomes' "none" (-1) as this
+ */
+export const BIOME_U8_NONE = 0xFF;
+
+/**
+ * Tree rule marker: no tree (see TreeRuleTable)
+ */
+export const TREE_NONE = 0xFF;
+
+/**
+ * Pre-built shapes per tree type (see getTreeTemplates)
+ */
+export const TREE_VARIANTS = 16;
+
+/**
+ * Voxel store reads: block never edited (see WasmVoxelStore)
+ */
+export const VOXEL_NONE = -1;
+
+/**
+ * Noise fields sampled by the native module (ChunkGenerator's terrain and swamp noise)
+ */
+export const NoiseField = {
+  TERRAIN: 0,
+  SWAMP: 1,
+} as const;
+
+export type NoiseFieldType = typeof NoiseField[keyof typeof NoiseField];
+
+// Byte layout of the native ChunkSurface struct (see cubiomes_wrapper.c)
+const CHUNK_SURFACE_HEIGHT = 0;
+const CHUNK_SURFACE_TOP_BLOCK = 256;
+const CHUNK_SURFACE_WATER_DEPTH = 512;
+const CHUNK_SURFACE_RIGHT = 768;
+const CHUNK_SURFACE_FRONT = 784;
+const CHUNK_SURFACE_BIOME = 800;
+const CHUNK_SURFACE_BYTES = 1056;
+
+// Byte layout of the native TreeTable struct (struct-of-arrays, 256 entries each)
+const TREE_TABLE_CHANCE = 0;
+const TREE_TABLE_DENSITY = 2048;
+const TREE_TABLE_PRIMARY = 2304;
+const TREE_TABLE_SECONDARY = 2560;
+
+// Byte layout of the native ChunkTrees struct (TreeRecord is 4 int32s)
+const CHUNK_TREES_COUNT = 0;
+const CHUNK_TREES_RECORDS = 4;
+const TREE_RECORD_INTS = 4;
+
+// Byte layout of the native TreeTemplateTable struct (int32 arrays indexed type * TREE_VARIANTS + variant)
+const TREE_TYPE_COUNT = 9;
+const TREE_TEMPLATES_START = 0;
+const TREE_TEMPLATES_COUNT = 576;
+const TREE_TEMPLATES_HEIGHT = 1152;
+const TREE_TEMPLATES_BLOCK_COUNT = 1728;
+const TREE_TEMPLATES_BLOCKS = 1732;
+
+// Byte layout of the native BiomeMetaTable struct (struct-of-arrays, 256 entries each)
+const BIOME_META_COUNT = 256;
+const BIOME_META_COLOR = 0;
+const BIOME_META_GRASS_COLOR = 1024;
+const BIOME_META_BASE_HEIGHT = 2048;
+const BIOME_META_TREES = 2304;
+const BIOME_META_FLAGS = 2560;
+const BIOME_META_OCEAN = 0x01;
+const BIOME_META_SNOWY = 0x02;
+
+/**
+ * Per-biome metadata copied out of the native table once at load
+ */
+interface BiomeMetaTable {
+  color: Uint32Array;       // 0xRRGGBB
+  grassColor: Uint32Array;  // 0xRRGGBB
+  baseHeight: Uint8Array;
+  trees: Uint8Array;        // 0 none, 1 dense, 2 sparse
+  flags: Uint8Array;        // BIOME_META_*
+}
+
+function readBiomeMetaTable(mod: CubiomesModule): BiomeMetaTable {
+  // Copies, so memory growth can't detach them
+  const ptr = mod._get_biome_meta_table();
+  const buffer = mod.HEAPU8.buffer;
+  return {
+    color: new Uint32Array(buffer, ptr + BIOME_META_COLOR, BIOME_META_COUNT).slice(),
+    grassColor: new Uint32Array(buffer, ptr + BIOME_META_GRASS_COLOR, BIOME_META_COUNT).slice(),
+    baseHeight: new Uint8Array(buffer, ptr + BIOME_META_BASE_HEIGHT, BIOME_META_COUNT).slice(),
+    trees: new Uint8Array(buffer, ptr + BIOME_META_TREES, BIOME_META_COUNT).slice(),
+    flags: new Uint8Array(buffer, ptr + BIOME_META_FLAGS, BIOME_META_COUNT).slice(),
+  };
+}
+
+function readTreeTemplates(mod: CubiomesModule): TreeTemplates | null {
+  const ptr = mod._get_tree_templates();
+  if (ptr === 0) return null;
+  
+  const buffer = mod.HEAPU8.buffer;
+  const n = TREE_TYPE_COUNT * TREE_VARIANTS;
+  const blockCount = mod.HEAP32[(ptr + TREE_TEMPLATES_BLOCK_COUNT) >> 2];
+  return {
+    start: new Int32Array(buffer, ptr + TREE_TEMPLATES_START, n).slice(),
+    count: new Int32Array(buffer, ptr + TREE_TEMPLATES_COUNT, n).slice(),
+    height: new Int32Array(buffer, ptr + TREE_TEMPLATES_HEIGHT, n).slice(),
+    blocks: new Uint32Array(buffer, ptr + TREE_TEMPLATES_BLOCKS, blockCount).slice(),
+  };
+}
+
+/**
+ * Shared tree shapes, for drawing the trees returned by WasmGenerator.genChunkTrees
+ */
+export function getTreeTemplates(): TreeTemplates {
+  if (!treeTemplates) throw new Error('Cubiomes module not loaded');
+  return treeTemplates;
+}
+
+function unpackRgb(color: number): [number, number, number] {
+  return [(color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF];
+}
+
+/**
+ * Biome names by ID (Minecraft 1.20 biome IDs)
+ */
+const BIOME_NAMES: Record<number, string> = {
+  0: 'Ocean',
+  1: 'Plains',
+  2: 'Desert',
+  3: 'Windswept Hills',
+  4: 'Forest',
+  5: 'Taiga',
+  6: 'Swamp',
+  7: 'River',
+  8: 'Nether Wastes',
+  9: 'The End',
+  10: 'Frozen Ocean',
+  11: 'Frozen River',
+  12: 'Snowy Plains',
+  13: 'Snowy Mountains',
+  14: 'Mushroom Fields',
+  15: 'Mushroom Field Shore',
+  16: 'Beach',
+  17: 'Desert Hills',
+  18: 'Wooded Hills',
+  19: 'Taiga Hills',
+  20: 'Mountain Edge',
+  21: 'Jungle',
+  22: 'Jungle Hills',
+  23: 'Sparse Jungle',
+  24: 'Deep Ocean',
+  25: 'Stony Shore',
+  26: 'Snowy Beach',
+  27: 'Birch Forest',
+  28: 'Birch Forest Hills',
+  29: 'Dark Forest',
+  30: 'Snowy Taiga',
+  31: 'Snowy Taiga Hills',
+  32: 'Old Growth Pine Taiga',
+  33: 'Old Growth Pine Taiga Hills',
+  34: 'Windswept Forest',
+  35: 'Savanna',
+  36: 'Savanna Plateau',
+  37: 'Badlands',
+  38: 'Wooded Badlands',
+  39: 'Badlands Plateau',
+  40: 'Small End Islands',
+  41: 'End Midlands',
+  42: 'End Highlands',
+  43: 'End Barrens',
+  44: 'Warm Ocean',
+  45: 'Lukewarm Ocean',
+  46: 'Cold Ocean',
+  47: 'Deep Warm Ocean',
+  48: 'Deep Lukewarm Ocean',
+  49: 'Deep Cold Ocean',
+  50: 'Deep Frozen Ocean',
+  // Modern biomes (1.18+)
+  127: 'The Void',
+  129: 'Sunflower Plains',
+  130: 'Desert Lakes',
+  131: 'Windswept Gravelly Hills',
+  132: 'Flower Forest',
+  133: 'Taiga Mountains',
+  134: 'Swamp Hills',
+  140: 'Ice Spikes',
+  149: 'Jungle Edge Mutated',
+  151: 'Modified Jungle Edge',
+  155: 'Old Growth Birch Forest',
+  156: 'Birch Forest Mountains',
+  157: 'Dark Forest Hills',
+  158: 'Snowy Taiga Mountains',
+  160: 'Old Growth Spruce Taiga',
+  161: 'Giant Spruce Taiga Hills',
+  162: 'Modified Gravelly Mountains',
+  163: 'Windswept Savanna',
+  164: 'Shattered Savanna Plateau',
+  165: 'Eroded Badlands',
+  166: 'Modified Wooded Badlands Plateau',
+  167: 'Modified Badlands Plateau',
+  168: 'Bamboo Jungle',
+  169: 'Bamboo Jungle Hills',
+  170: 'Soul Sand Valley',
+  171: 'Crimson Forest',
+  172: 'Warped Forest',
+  173: 'Basalt Deltas',
+  174: 'Dripstone Caves',
+  175: 'Lush Caves',
+  177: 'Meadow',
+  178: 'Grove',
+  179: 'Snowy Slopes',
+  180: 'Frozen Peaks',
+  181: 'Jagged Peaks',
+  182: 'Stony Peaks',
+  183: 'Cherry Grove',
+  184: 'Deep Dark',
+  185: 'Mangrove Swamp',
+};
+
+// Byte layout of the native ChunkJobResult struct
+const CHUNK_RESULT_CX = 0;
+const CHUNK_RESULT_CZ = 4;
+const CHUNK_RESULT_OK = 8;
+const CHUNK_RESULT_SURFACE = 16;
+
+/**
+ * Surface of one chunk as produced by the native surface pass (owned copies)
+ */
+export interface ChunkSurface {
+  heightMap: Uint8Array;
+  biomeMap: Uint8Array;  // BIOME_U8_NONE where cubiomes had no biome
+  topBlock: Uint8Array;
+  waterDepth: Uint8Array;
+  rightNeighborHeights: Uint8Array;
+  frontNeighborHeights: Uint8Array;
+}
+
+/**
+ * Per-biome tree rules for the native tree placer (256 entries each)
+ * A biome grows `primary`, or when `secondary` is set, primary with
+ * probability `chance` and secondary otherwise.
+ */
+export interface TreeRuleTable {
+  chance: Float64Array;
+  density: Uint8Array;    // Target trees per chunk
+  primary: Uint8Array;    // TreeType or TREE_NONE
+  secondary: Uint8Array;  // TreeType or TREE_NONE
+}
+
+/**
+ * One tree placed by the native tree placer, drawn as a shared template
+ */
+export interface ChunkTree {
+  x: number;        // Chunk-local column
+  z: number;
+  type: number;     // TreeType
+  variant: number;  // 0 .. TREE_VARIANTS - 1
+}
+
+/**
+ * Shared tree shapes, copied out of the native template table once at load
+ * Template (type, variant) is blocks[start[i] .. start[i] + count[i]) with
+ * i = type * TREE_VARIANTS + variant. Blocks are packed uint32 records:
+ * tree-relative dx, dy, dz biased by 128 in the low three bytes, block
+ * kind (log/leaves/cactus) in the top byte.
+ */
+export interface TreeTemplates {
+  start: Int32Array;
+  count: Int32Array;
+  height: Int32Array;  // Trunk height
+  blocks: Uint32Array;
+}
+
+// render_biome_rgba flags
+const RENDER_HILLSHADE = 1;
+
+/**
+ * Options for WasmGenerator.renderBiomeMap
+ */
+export interface BiomeMapOptions {
+  palette?: Uint32Array;  // 0xRRGGBB per biome ID (256 entries); built-in biome colors if omitted
+  hillshade?: boolean;    // Shade by biome base height
+}
+
+/**
+ * One level of a biome pyramid (see WasmGenerator.genBiomePyramid)
+ */
+export interface BiomePyramidLevel {
+  scale: number;      // Blocks per cell: 4, 16, 64 or 256
+  x: number;          // First cell, in this level's cells
+  z: number;
+  width: number;
+  height: number;
+  biomes: Uint8Array; // Row-major, BIOME_U8_NONE for none
+}
+
+/**
+ * A chunk surface finished by a background worker
+ */
+export interface CompletedChunkSurface {
+  chunkX: number;
+  chunkZ: number;
+  surface: ChunkSurface | null;  // null if generation failed
+}
+
+/**
+ * Split a 64-bit seed into the (hi, lo) words the native API takes
+ */
+function splitSeed(seed: bigint): [number, number] {
+  return [Number((seed >> BigInt(32)) & BigInt(0xFFFFFFFF)), Number(seed & BigInt(0xFFFFFFFF))];
+}
+
 /**
  * WASM-based biome generator
+ * Each instance owns its own native generator handle, so several
+ * dimensions or seeds can be generated side by side without re-running
+ * setupGenerator/applySeed on every switch.
  */
 export class WasmGenerator {
   private initialized = false;
   private seed: bigint;
+  private dimension: DimensionType;
+  private handle = 0;
   
-  constructor(seed?: number | bigint) {
+  constructor(seed?: number | bigint, dimension: DimensionType = Dimension.OVERWORLD) {
     this.seed = BigInt(seed ?? Math.floor(Math.random() * 2147483647));
+    this.dimension = dimension;
   }
   
   /**
@@ -126,16 +579,93 @@ export class WasmGenerator {
     
     if (!module) throw new Error('Failed to load cubiomes module');
     
-    // Initialize generator for the specified Minecraft version
-    module._init_generator(mcVersion, 0);
+    // Create a native generator for the specified Minecraft version
+    this.handle = module._create_generator(mcVersion, 0);
+    if (this.handle === 0) {
+      throw new Error('Failed to create cubiomes generator');
+    }
     
     // Apply seed
-    const seedHi = Number((this.seed >> BigInt(32)) & BigInt(0xFFFFFFFF));
-    const seedLo = Number(this.seed & BigInt(0xFFFFFFFF));
-    module._apply_seed(seedHi, seedLo, Dimension.OVERWORLD);
+    const [seedHi, seedLo] = splitSeed(this.seed);
+    module._generator_apply_seed(this.handle, seedHi, seedLo, this.dimension);
     
     this.initialized = true;
-    console.log(`🌍 Generator initialized with seed: ${this.seed.toString(16)}`);
+    console.log(`🌍 Generator initialized with seed: ${this.seed.toString(16)} (dim ${this.dimension})`);
+  }
+  
+  /**
+   * Switch seed and/or dimension in place
+   * Recently used combinations come back from the handle's native snapshot
+   * cache (a memcpy) instead of re-running the climate noise setup.
+   * A change stops background workers (see startWorkers).
+   */
+  setSeed(seed: number | bigint, dimension: DimensionType = this.dimension): void {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    this.seed = BigInt(seed);
+    this.dimension = dimension;
+    const [seedHi, seedLo] = splitSeed(this.seed);
+    module._generator_apply_seed(this.handle, seedHi, seedLo, dimension);
+  }
+  
+  /**
+   * Copy the fully seeded native state out, for restore() later
+   * Only valid for this generator (the native state points into itself).
+   */
+  snapshot(): Uint8Array {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const size = module._generator_snapshot_size();
+    const ptr = module._malloc(size);
+    try {
+      if (module._generator_snapshot(this.handle, ptr) !== 0) {
+        throw new Error('Failed to snapshot generator');
+      }
+      return module.HEAPU8.slice(ptr, ptr + size);
+    } finally {
+      module._free(ptr);
+    }
+  }
+  
+  /**
+   * Restore a state taken with snapshot() (no noise setup)
+   * Seed and dimension come back from the snapshot itself. A change stops
+   * background workers (see startWorkers).
+   */
+  restore(snapshot: Uint8Array): void {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._malloc(snapshot.length);
+    try {
+      module.HEAPU8.set(snapshot, ptr);
+      if (module._generator_restore(this.handle, ptr) !== 0) {
+        throw new Error('Snapshot does not belong to this generator');
+      }
+    } finally {
+      module._free(ptr);
+    }
+    const seedHi = BigInt(module._generator_seed_hi(this.handle) >>> 0);
+    const seedLo = BigInt(module._generator_seed_lo(this.handle) >>> 0);
+    this.seed = BigInt.asIntN(64, (seedHi << BigInt(32)) | seedLo);
+    this.dimension = module._generator_dim(this.handle) as DimensionType;
+  }
+  
+  /**
+   * Release the native generator handle
+   */
+  destroy(): void {
+    if (module && this.handle !== 0) {
+      // Also stops any background workers
+      module._destroy_generator(this.handle);
+    }
+    this.handle = 0;
+    this.initialized = false;
   }
   
   /**
@@ -145,13 +675,92 @@ export class WasmGenerator {
     if (!this.initialized || !module) {
       throw new Error('Generator not initialized');
     }
-    return module._get_biome_at(scale, x, y, z);
+    return module._generator_get_biome_at(this.handle, scale, x, y, z);
   }
   
   /**
-   * Generate biomes for a 2D area
+   * Get biomes at many scattered points in one native call
+   * Nearby points share generation work, so batch whatever can be batched.
+   * @param xs, zs - Coordinates at the given scale
+   * @param y - Y coordinate for every point, or one per point
+   * @returns Biome IDs in input order (-1 where generation failed)
    */
-  genBiomes2D(
+  getBiomesAtPoints(scale: number, xs: ArrayLike<number>, zs: ArrayLike<number>, y: number | ArrayLike<number> = 63): Int32Array {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const n = xs.length;
+    if (n === 0) return new Int32Array(0);
+    
+    const ptr = module._generator_point_buffer(this.handle, n);
+    if (ptr === 0) {
+      throw new Error('Failed to allocate point buffer');
+    }
+    
+    // Layout: xs, ys, zs, out - n ints each
+    const start = ptr >> 2;
+    const heap = module.HEAP32;
+    heap.set(xs, start);
+    if (typeof y === 'number') {
+      heap.fill(y, start + n, start + 2 * n);
+    } else {
+      heap.set(y, start + n);
+    }
+    heap.set(zs, start + 2 * n);
+    
+    const out = ptr + 12 * n;
+    if (module._get_biomes_at_points(this.handle, scale, ptr, ptr + 4 * n, ptr + 8 * n, n, out) !== 0) {
+      throw new Error('Biome point query failed');
+    }
+    return module.HEAP32.slice(out >> 2, (out >> 2) + n);
+  }
+  
+  /**
+   * Find a spawn column near the origin natively (coarse-to-fine spiral)
+   * @param maxRadius - Search radius in blocks
+   * @param accept - Per biome ID (256 entries), non-zero where spawning is allowed
+   * @returns Block position, or null if nothing within maxRadius qualifies
+   */
+  findSpawn(maxRadius: number, accept: Uint8Array): { x: number; z: number } | null {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    module.HEAPU8.set(accept.subarray(0, 256), module._get_spawn_table(this.handle));
+    
+    const ptr = module._generator_point_buffer(this.handle, 1);
+    if (ptr === 0) {
+      throw new Error('Failed to allocate point buffer');
+    }
+    
+    const result = module._find_spawn(this.handle, maxRadius, ptr);
+    if (result < 0) {
+      throw new Error('Spawn search failed');
+    }
+    if (result === 0) return null;
+    
+    const start = ptr >> 2;
+    return { x: module.HEAP32[start], z: module.HEAP32[start + 1] };
+  }
+  
+  /**
+   * Native biome tile cache counters (getBiomeAt and the area generators share it)
+   */
+  getCacheStats(): { hits: number; misses: number } {
+    if (!module || this.handle === 0) return { hits: 0, misses: 0 };
+    return {
+      hits: module._generator_cache_hits(this.handle) >>> 0,
+      misses: module._generator_cache_misses(this.handle) >>> 0,
+    };
+  }
+  
+  /**
+   * Generate biomes for a 2D area as a view into the WASM output arena
+   * No copy is made: the view is only valid until the next generation call
+   * on this generator (and until the heap grows), so read it right away or copy it.
+   */
+  genBiomes2DView(
     scale: number,
     x: number,
     z: number,
@@ -163,91 +772,425 @@ export class WasmGenerator {
       throw new Error('Generator not initialized');
     }
     
-    // Allocate buffer
-    const bufferPtr = module._alloc_biome_buffer(sx, sz);
+    const ptr = module._generator_gen_biomes_2d(this.handle, scale, x, z, sx, sz, y);
+    if (ptr === 0) {
+      throw new Error('Biome generation failed');
+    }
     
-    // Generate biomes
-    const result = module._gen_biomes_2d(bufferPtr, scale, x, z, sx, sz, y);
+    // Re-read HEAP32 after the call: memory growth replaces the buffer
+    const start = ptr >> 2;
+    return module.HEAP32.subarray(start, start + sx * sz);
+  }
+  
+  /**
+   * Generate biomes for a 2D area with one byte per cell
+   * Same as genBiomes2DView (and the same lifetime rules), at a quarter of the size.
+   */
+  genBiomes2DU8View(
+    scale: number,
+    x: number,
+    z: number,
+    sx: number,
+    sz: number,
+    y: number = 63
+  ): Uint8Array {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._generator_gen_biomes_2d_u8(this.handle, scale, x, z, sx, sz, y);
+    if (ptr === 0) {
+      throw new Error('Biome generation failed');
+    }
+    
+    return module.HEAPU8.subarray(ptr, ptr + sx * sz);
+  }
+  
+  /**
+   * Generate a biome mip chain in one native call (for LOD, minimap and editor views)
+   * @param x, z, width, height - Level 0 region in scale-4 cells
+   * @param levels - 1 to 4 (scales 4, 16, 64, 256)
+   * @returns Levels finest first; level n covers the same area at scale 4^(n+1)
+   *          (from 1.18, point-sampled from level 0 rather than generated per scale)
+   */
+  genBiomePyramid(x: number, z: number, width: number, height: number, levels: number): BiomePyramidLevel[] {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const size = module._biome_pyramid_size(x, z, width, height, levels);
+    if (size === 0) {
+      throw new Error('Invalid biome pyramid request');
+    }
+    
+    const ptr = module._malloc(size);
+    try {
+      if (module._gen_biome_pyramid(this.handle, x, z, width, height, levels, ptr) !== 0) {
+        throw new Error('Biome pyramid generation failed');
+      }
+      
+      const result: BiomePyramidLevel[] = [];
+      const heap = module.HEAPU8;
+      let offset = ptr;
+      for (let level = 0; level < levels; level++) {
+        // Same ranges as the native side: floor-shift the level 0 bounds
+        const shift = 2 * level;
+        const lx = x >> shift;
+        const lz = z >> shift;
+        const lw = ((x + width - 1) >> shift) - lx + 1;
+        const lh = ((z + height - 1) >> shift) - lz + 1;
+        result.push({
+          scale: 4 << shift,
+          x: lx,
+          z: lz,
+          width: lw,
+          height: lh,
+          biomes: heap.slice(offset, offset + lw * lh),
+        });
+        offset += lw * lh;
+      }
+      return result;
+    } finally {
+      module._free(ptr);
+    }
+  }
+  
+  /**
+   * Rasterize a biome map to RGBA pixels in one native call
+   * @param scale - Blocks per pixel (1, 4, 16, 64 or 256)
+   * @param x, z - First cell at that scale
+   * @returns width * height * 4 bytes, ready for new ImageData(pixels, width, height)
+   */
+  renderBiomeMap(
+    scale: number,
+    x: number,
+    z: number,
+    width: number,
+    height: number,
+    options: BiomeMapOptions = {}
+  ): Uint8ClampedArray {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    let palette = 0;
+    if (options.palette) {
+      palette = module._get_render_palette(this.handle);
+      new Uint32Array(module.HEAPU8.buffer, palette, 256).set(options.palette.subarray(0, 256));
+    }
+    
+    const size = width * height * 4;
+    const ptr = module._malloc(size);
+    try {
+      const flags = options.hillshade ? RENDER_HILLSHADE : 0;
+      if (module._render_biome_rgba(this.handle, scale, x, z, width, height, palette, flags, ptr) !== 0) {
+        throw new Error('Biome map rendering failed');
+      }
+      // Copy into a plain buffer: threaded builds' heap is a SharedArrayBuffer,
+      // which ImageData refuses
+      const out = new Uint8ClampedArray(size);
+      out.set(module.HEAPU8.subarray(ptr, ptr + size));
+      return out;
+    } finally {
+      module._free(ptr);
+    }
+  }
+  
+  /**
+   * Generate the scale-1 biomes of a chunk plus a halo border in one native call
+   * Returns a (16 + 2*halo)^2 row-major view into the WASM output arena whose
+   * first cell is block (cx*16 - halo, cz*16 - halo). Same lifetime rules as genBiomes2DView.
+   */
+  genChunkBiomesHalo(chunkX: number, chunkZ: number, halo: number): Int32Array {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._gen_chunk_biomes_halo(this.handle, chunkX, chunkZ, halo);
+    if (ptr === 0) {
+      throw new Error('Biome generation failed');
+    }
+    
+    const size = 16 + 2 * halo;
+    const start = ptr >> 2;
+    return module.HEAP32.subarray(start, start + size * size);
+  }
+  
+  /**
+   * Generate the scale-1 biomes of a rectangular region of chunks in one native call
+   * Returns a (ncx*16 + 2*halo) x (ncz*16 + 2*halo) row-major view whose first cell
+   * is block (cx0*16 - halo, cz0*16 - halo). Same lifetime rules as genBiomes2DView.
+   */
+  genRegionBiomes(chunkX0: number, chunkZ0: number, countX: number, countZ: number, halo: number): Int32Array {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._gen_region_biomes(this.handle, chunkX0, chunkZ0, countX, countZ, halo);
+    if (ptr === 0) {
+      throw new Error('Biome generation failed');
+    }
+    
+    const sx = countX * 16 + 2 * halo;
+    const sz = countZ * 16 + 2 * halo;
+    const start = ptr >> 2;
+    return module.HEAP32.subarray(start, start + sx * sz);
+  }
+  
+  /**
+   * Configure the native surface pass and noise fields
+   * Stops background workers (see startWorkers).
+   * @param seed - ChunkGenerator seed (noise is seeded exactly like its PerlinNoise instances)
+   * @param table - Top block per biome ID (256 entries, SURFACE_SWAMP for swamps)
+   */
+  configureSurface(seed: number, table: Uint8Array): void {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._get_surface_table(this.handle);
+    module.HEAPU8.set(table.subarray(0, 256), ptr);
+    module._configure_surface(this.handle, seed);
+  }
+  
+  /**
+   * Configure the native tree placer
+   * Uses the seed given to configureSurface, so call that first.
+   */
+  configureTrees(table: TreeRuleTable): void {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._get_tree_table(this.handle);
+    const heap = module.HEAPU8;
+    new Float64Array(heap.buffer, ptr + TREE_TABLE_CHANCE, 256).set(table.chance.subarray(0, 256));
+    heap.set(table.density.subarray(0, 256), ptr + TREE_TABLE_DENSITY);
+    heap.set(table.primary.subarray(0, 256), ptr + TREE_TABLE_PRIMARY);
+    heap.set(table.secondary.subarray(0, 256), ptr + TREE_TABLE_SECONDARY);
+  }
+  
+  /**
+   * Sample a grid of 2D noise in one native call (batch PerlinNoise.sample2D)
+   * Cell (i, j) equals sample2D((x0 + i) * scale, (z0 + j) * scale) bit for bit.
+   * Returns a view into the WASM heap, valid until the next noise call on this generator.
+   */
+  genNoiseGrid(field: NoiseFieldType, x0: number, z0: number, nx: number, nz: number, scale: number): Float64Array {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._gen_noise_grid(this.handle, field, x0, z0, nx, nz, scale);
+    if (ptr === 0) {
+      throw new Error('Noise generation failed (surface not configured?)');
+    }
+    
+    const start = ptr >> 3;
+    return module.HEAPF64.subarray(start, start + nx * nz);
+  }
+  
+  /**
+   * Generate a chunk's biomes, heights, smoothing and top blocks in one native call
+   */
+  genChunkSurface(chunkX: number, chunkZ: number): ChunkSurface {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._gen_chunk_surface(this.handle, chunkX, chunkZ);
+    if (ptr === 0) {
+      throw new Error('Surface generation failed');
+    }
+    return this.readChunkSurface(module.HEAPU8, ptr);
+  }
+  
+  /**
+   * Generate the surfaces of a rectangular region of chunks in one native call
+   * @return countX * countZ surfaces, row-major (chunk (x0 + i, z0 + j) at j * countX + i)
+   */
+  genRegionSurfaces(chunkX0: number, chunkZ0: number, countX: number, countZ: number): ChunkSurface[] {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
+    }
+    
+    const ptr = module._gen_region_surfaces(this.handle, chunkX0, chunkZ0, countX, countZ);
+    if (ptr === 0) {
+      throw new Error('Surface generation failed');
+    }
     
-    if (result !== 0) {
-      module._free_buffer(bufferPtr);
-      throw new Error(`Biome generation failed with code ${result}`);
+    const heap = module.HEAPU8;
+    const surfaces: ChunkSurface[] = [];
+    for (let i = 0; i < countX * countZ; i++) {
+      surfaces.push(this.readChunkSurface(heap, ptr + i * CHUNK_SURFACE_BYTES));
+    }
+    return surfaces;
+  }
+  
+  /**
+   * Place a chunk's trees natively on its surface (deterministic per seed and chunk)
+   * Shapes are shared templates, see getTreeTemplates.
+   */
+  genChunkTrees(chunkX: number, chunkZ: number, surface: ChunkSurface): ChunkTree[] {
+    if (!this.initialized || !module) {
+      throw new Error('Generator not initialized');
     }
     
-    // Copy results
-    const biomes = new Int32Array(sx * sz);
-    for (let i = 0; i < sx * sz; i++) {
-      biomes[i] = module.getValue(bufferPtr + i * 4, 'i32');
+    const input = module._get_tree_surface(this.handle);
+    const heap = module.HEAPU8;
+    heap.set(surface.heightMap, input + CHUNK_SURFACE_HEIGHT);
+    heap.set(surface.topBlock, input + CHUNK_SURFACE_TOP_BLOCK);
+    heap.set(surface.biomeMap, input + CHUNK_SURFACE_BIOME);
+    
+    const ptr = module._gen_chunk_trees(this.handle, chunkX, chunkZ);
+    if (ptr === 0) {
+      throw new Error('Tree generation failed (surface not configured?)');
     }
     
-    // Free buffer
-    module._free_buffer(bufferPtr);
+    const heap32 = module.HEAP32;
+    const count = heap32[(ptr + CHUNK_TREES_COUNT) >> 2];
     
-    return biomes;
+    const trees: ChunkTree[] = [];
+    for (let i = 0; i < count; i++) {
+      const r = ((ptr + CHUNK_TREES_RECORDS) >> 2) + i * TREE_RECORD_INTS;
+      trees.push({ x: heap32[r], z: heap32[r + 1], type: heap32[r + 2], variant: heap32[r + 3] });
+    }
+    return trees;
+  }
+  
+  /**
+   * Start background chunk workers (threaded build only)
+   * Workers copy the current seed and surface setup, so call after configureSurface.
+   * setSeed/restore to another world and configureSurface stop them (queued
+   * and unpolled chunks are dropped); call this again afterwards.
+   * @return Number of workers started; 0 if this build has no thread support
+   */
+  startWorkers(threads: number): number {
+    if (!this.initialized || !module) return 0;
+    return module._start_chunk_workers(this.handle, threads);
+  }
+  
+  /**
+   * Stop background chunk workers, dropping queued and unpolled chunks
+   */
+  stopWorkers(): void {
+    if (module && this.handle !== 0) {
+      module._stop_chunk_workers(this.handle);
+    }
+  }
+  
+  /**
+   * Queue a chunk surface for background generation
+   * @return false if the queue is full or no workers are running
+   */
+  submitChunk(chunkX: number, chunkZ: number): boolean {
+    if (!this.initialized || !module) return false;
+    return module._submit_chunk(this.handle, chunkX, chunkZ) === 0;
+  }
+  
+  /**
+   * Take the next chunk surface finished by a background worker (never blocks)
+   * @return The finished chunk, or null if none is ready
+   */
+  pollCompleted(): CompletedChunkSurface | null {
+    if (!this.initialized || !module) return null;
+    
+    const ptr = module._poll_completed(this.handle);
+    if (ptr === 0) return null;
+    
+    const heap32 = module.HEAP32;
+    const ok = heap32[(ptr + CHUNK_RESULT_OK) >> 2] !== 0;
+    return {
+      chunkX: heap32[(ptr + CHUNK_RESULT_CX) >> 2],
+      chunkZ: heap32[(ptr + CHUNK_RESULT_CZ) >> 2],
+      surface: ok ? this.readChunkSurface(module.HEAPU8, ptr + CHUNK_RESULT_SURFACE) : null,
+    };
+  }
+  
+  /**
+   * Copy one native ChunkSurface out of the heap
+   * Copies never share the (possibly shared) wasm memory buffer.
+   */
+  private readChunkSurface(heap: Uint8Array, ptr: number): ChunkSurface {
+    return {
+      heightMap: heap.slice(ptr + CHUNK_SURFACE_HEIGHT, ptr + CHUNK_SURFACE_HEIGHT + 256),
+      biomeMap: heap.slice(ptr + CHUNK_SURFACE_BIOME, ptr + CHUNK_SURFACE_BIOME + 256),
+      topBlock: heap.slice(ptr + CHUNK_SURFACE_TOP_BLOCK, ptr + CHUNK_SURFACE_TOP_BLOCK + 256),
+      waterDepth: heap.slice(ptr + CHUNK_SURFACE_WATER_DEPTH, ptr + CHUNK_SURFACE_WATER_DEPTH + 256),
+      rightNeighborHeights: heap.slice(ptr + CHUNK_SURFACE_RIGHT, ptr + CHUNK_SURFACE_RIGHT + 16),
+      frontNeighborHeights: heap.slice(ptr + CHUNK_SURFACE_FRONT, ptr + CHUNK_SURFACE_FRONT + 16),
+    };
+  }
+  
+  /**
+   * Generate biomes for a 2D area (owned copy)
+   */
+  genBiomes2D(
+    scale: number,
+    x: number,
+    z: number,
+    sx: number,
+    sz: number,
+    y: number = 63
+  ): Int32Array {
+    return this.genBiomes2DView(scale, x, z, sx, sz, y).slice();
   }
   
   /**
    * Check if biome is oceanic
    */
   isOcean(biomeId: number): boolean {
-    if (!module) return false;
-    return module._is_ocean(biomeId) !== 0;
+    if (!biomeMeta) return false;
+    return (biomeMeta.flags[biomeId & 0xFF] & BIOME_META_OCEAN) !== 0;
   }
   
   /**
    * Check if biome is snowy
    */
   isSnowy(biomeId: number): boolean {
-    if (!module) return false;
-    return module._is_snowy_biome(biomeId) !== 0;
+    if (!biomeMeta) return false;
+    return (biomeMeta.flags[biomeId & 0xFF] & BIOME_META_SNOWY) !== 0;
   }
   
   /**
    * Get biome color as RGB array
    */
   getBiomeColor(biomeId: number): [number, number, number] {
-    if (!module) return [128, 128, 128];
-    const color = module._get_biome_color(biomeId);
-    return [
-      (color >> 16) & 0xFF,
-      (color >> 8) & 0xFF,
-      color & 0xFF,
-    ];
+    if (!biomeMeta) return [128, 128, 128];
+    return unpackRgb(biomeMeta.color[biomeId & 0xFF]);
   }
   
   /**
    * Get base terrain height for biome
    */
   getBiomeBaseHeight(biomeId: number): number {
-    if (!module) return 64;
-    return module._get_biome_base_height(biomeId);
+    if (!biomeMeta) return 64;
+    return biomeMeta.baseHeight[biomeId & 0xFF];
   }
   
   /**
    * Check if biome has trees
    */
   biomeHasTrees(biomeId: number): 0 | 1 | 2 {
-    if (!module) return 0;
-    return module._biome_has_trees(biomeId) as 0 | 1 | 2;
+    if (!biomeMeta) return 0;
+    return biomeMeta.trees[biomeId & 0xFF] as 0 | 1 | 2;
   }
   
   /**
    * Get biome grass color
    */
   getBiomeGrassColor(biomeId: number): [number, number, number] {
-    if (!module) return [141, 179, 96];
-    const color = module._get_biome_grass_color(biomeId);
-    return [
-      (color >> 16) & 0xFF,
-      (color >> 8) & 0xFF,
-      color & 0xFF,
-    ];
+    if (!biomeMeta) return [141, 179, 96];
+    return unpackRgb(biomeMeta.grassColor[biomeId & 0xFF]);
   }
   
   getSeed(): bigint {
     return this.seed;
   }
   
+  getDimension(): DimensionType {
+    return this.dimension;
+  }
+  
   getSeedNumber(): number {
     return Number(this.seed & BigInt(0x7FFFFFFF));
   }
@@ -256,111 +1199,99 @@ export class WasmGenerator {
    * Get biome name from biome ID
    */
   getBiomeName(biomeId: number): string {
-    // Biome name mapping based on Minecraft 1.20 biome IDs
-    const biomeNames: Record<number, string> = {
-      0: 'Ocean',
-      1: 'Plains',
-      2: 'Desert',
-      3: 'Windswept Hills',
-      4: 'Forest',
-      5: 'Taiga',
-      6: 'Swamp',
-      7: 'River',
-      8: 'Nether Wastes',
-      9: 'The End',
-      10: 'Frozen Ocean',
-      11: 'Frozen River',
-      12: 'Snowy Plains',
-      13: 'Snowy Mountains',
-      14: 'Mushroom Fields',
-      15: 'Mushroom Field Shore',
-      16: 'Beach',
-      17: 'Desert Hills',
-      18: 'Wooded Hills',
-      19: 'Taiga Hills',
-      20: 'Mountain Edge',
-      21: 'Jungle',
-      22: 'Jungle Hills',
-      23: 'Sparse Jungle',
-      24: 'Deep Ocean',
-      25: 'Stony Shore',
-      26: 'Snowy Beach',
-      27: 'Birch Forest',
-      28: 'Birch Forest Hills',
-      29: 'Dark Forest',
-      30: 'Snowy Taiga',
-      31: 'Snowy Taiga Hills',
-      32: 'Old Growth Pine Taiga',
-      33: 'Old Growth Pine Taiga Hills',
-      34: 'Windswept Forest',
-      35: 'Savanna',
-      36: 'Savanna Plateau',
-      37: 'Badlands',
-      38: 'Wooded Badlands',
-      39: 'Badlands Plateau',
-      40: 'Small End Islands',
-      41: 'End Midlands',
-      42: 'End Highlands',
-      43: 'End Barrens',
-      44: 'Warm Ocean',
-      45: 'Lukewarm Ocean',
-      46: 'Cold Ocean',
-      47: 'Deep Warm Ocean',
-      48: 'Deep Lukewarm Ocean',
-      49: 'Deep Cold Ocean',
-      50: 'Deep Frozen Ocean',
-      // Modern biomes (1.18+)
-      127: 'The Void',
-      129: 'Sunflower Plains',
-      130: 'Desert Lakes',
-      131: 'Windswept Gravelly Hills',
-      132: 'Flower Forest',
-      133: 'Taiga Mountains',
-      134: 'Swamp Hills',
-      140: 'Ice Spikes',
-      149: 'Jungle Edge Mutated',
-      151: 'Modified Jungle Edge',
-      155: 'Old Growth Birch Forest',
-      156: 'Birch Forest Mountains',
-      157: 'Dark Forest Hills',
-      158: 'Snowy Taiga Mountains',
-      160: 'Old Growth Spruce Taiga',
-      161: 'Giant Spruce Taiga Hills',
-      162: 'Modified Gravelly Mountains',
-      163: 'Windswept Savanna',
-      164: 'Shattered Savanna Plateau',
-      165: 'Eroded Badlands',
-      166: 'Modified Wooded Badlands Plateau',
-      167: 'Modified Badlands Plateau',
-      168: 'Bamboo Jungle',
-      169: 'Bamboo Jungle Hills',
-      170: 'Soul Sand Valley',
-      171: 'Crimson Forest',
-      172: 'Warped Forest',
-      173: 'Basalt Deltas',
-      174: 'Dripstone Caves',
-      175: 'Lush Caves',
-      177: 'Meadow',
-      178: 'Grove',
-      179: 'Snowy Slopes',
-      180: 'Frozen Peaks',
-      181: 'Jagged Peaks',
-      182: 'Stony Peaks',
-      183: 'Cherry Grove',
-      184: 'Deep Dark',
-      185: 'Mangrove Swamp',
-    };
-
-    return biomeNames[biomeId] || `Unknown (${biomeId})`;
+    return BIOME_NAMES[biomeId] || `Unknown (${biomeId})`;
   }
 }
 
 /**
  * Create and initialize a WASM generator
  */
-export async function createWasmGenerator(seed?: number | bigint): Promise<WasmGenerator> {
-  const generator = new WasmGenerator(seed);
+export async function createWasmGenerator(
+  seed?: number | bigint,
+  dimension: DimensionType = Dimension.OVERWORLD
+): Promise<WasmGenerator> {
+  const generator = new WasmGenerator(seed, dimension);
   await generator.init();
   return generator;
 }
 
+/**
+ * Per-block world edits, kept natively (wasm/voxel_store.c)
+ * Chunks are split into 16-high sections holding a small palette and a
+ * bit-packed index per block, so reads are O(1) and sparse edits stay
+ * cheap. Values are 0..254 (callers store BlockType); y is 0..127.
+ */
+export class WasmVoxelStore {
+  private handle: number;
+  
+  constructor() {
+    if (!module) throw new Error('Cubiomes module not loaded');
+    this.handle = module._create_voxel_store();
+    if (this.handle === 0) {
+      throw new Error('Failed to create voxel store');
+    }
+  }
+  
+  /**
+   * Edit at a block, or VOXEL_NONE if it was never edited
+   */
+  get(x: number, y: number, z: number): number {
+    if (!module || this.handle === 0) return VOXEL_NONE;
+    return module._voxel_get(this.handle, x, y, z);
+  }
+  
+  /**
+   * Record an edit (VOXEL_NONE clears it)
+   * @return false if y or value is out of range
+   */
+  set(x: number, y: number, z: number, value: number): boolean {
+    if (!module || this.handle === 0) return false;
+    return module._voxel_set(this.handle, x, y, z, value) !== 0;
+  }
+  
+  /**
+   * Record the same edit over a box of blocks (bounds inclusive)
+   * @return Number of blocks written
+   */
+  fill(x0: number, y0: number, z0: number, x1: number, y1: number, z1: number, value: number): number {
+    if (!module || this.handle === 0) return 0;
+    const written = module._voxel_fill(this.handle, x0, y0, z0, x1, y1, z1, value);
+    if (written < 0) {
+      throw new Error('Voxel fill failed');
+    }
+    return written;
+  }
+  
+  /**
+   * Y of the highest edit in a column, skipping `ignore`, or VOXEL_NONE
+   */
+  columnTop(x: number, z: number, ignore: number = VOXEL_NONE): number {
+    if (!module || this.handle === 0) return VOXEL_NONE;
+    return module._voxel_column_top(this.handle, x, z, ignore);
+  }
+  
+  /**
+   * Edits of one chunk, skipping `ignore`, as packed records:
+   * local x in bits 0-3, local z in bits 4-7, y in bits 8-15, value above
+   */
+  chunkBlocks(chunkX: number, chunkZ: number, ignore: number = VOXEL_NONE): Uint32Array {
+    if (!module || this.handle === 0) return new Uint32Array(0);
+    
+    const ptr = module._voxel_chunk_blocks(this.handle, chunkX, chunkZ, ignore);
+    if (ptr === 0) {
+      throw new Error('Failed to list voxel edits');
+    }
+    const count = module.HEAP32[ptr >> 2];
+    return new Uint32Array(module.HEAPU8.buffer, ptr + 4, count).slice();
+  }
+  
+  /**
+   * Release the native store
+   */
+  destroy(): void {
+    if (module && this.handle !== 0) {
+      module._destroy_voxel_store(this.handle);
+    }
+    this.handle = 0;
+  }
+}
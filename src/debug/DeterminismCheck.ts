@@ -0,0 +1,382 @@
+/**
+ * Determinism Check - golden digests of biome and chunk output
+ * 
+ * Hashes generator output over a fixed matrix of seeds, versions, scales and
+ * coordinates (negative ones included) so a faster code path can be checked
+ * against recorded output before it ships:
+ * 1. "biomes"    - raw cubiomes grids (WasmGenerator.genBiomes2DView)
+ * 2. "pyramid"   - each level of WasmGenerator.genBiomePyramid
+ * 3. "surface"   - native surface pass with a synthetic surface table
+ * 4. "noise"     - surface noise grids (WasmGenerator.genNoiseGrid)
+ * 5. "trees"     - native tree placement on synthetic input (WasmGenerator.genChunkTrees)
+ * 6. "variants"  - the shape chosen for each of those trees
+ * 7. "templates" - the shared tree shapes, per type (getTreeTemplates)
+ * 8. "chunkdata" - full ChunkData from ChunkGenerator.generateChunk, trees included
+ * 
+ * All but "chunkdata" use the same matrix and line format as
+ * wasm/native/golden.c, so a golden file recorded natively can be checked
+ * here and vice versa. Record "biomes" and "pyramid" natively: golden.c
+ * records them from plain genBiomes, while this file only sees the
+ * wrapper's fast paths.
+ * Works in the browser console and in Node (scripts/determinism-check.mjs;
+ * the cubiomes module loads from public/).
+ */
+
+import {
+  WasmGenerator,
+  loadCubiomesModule,
+  getNativeMcVersion,
+  getTreeTemplates,
+  NoiseField,
+  SURFACE_SWAMP,
+  TREE_NONE,
+  TREE_VARIANTS,
+} from '../cubiomes/wasm-bindings';
+import type { ChunkSurface, TreeRuleTable } from '../cubiomes/wasm-bindings';
+import { ChunkGenerator } from '../world/ChunkGenerator';
+import type { ChunkData } from '../world/ChunkGenerator';
+
+// Matrix - keep in sync with wasm/native/golden.c
+const MINORS = [12, 16, 18, 20];
+const SEEDS = [0n, 42n, -1n, -4172144997902289642n];
+const SCALES = [1, 4, 16, 64, 256];
+const ORIGINS: [number, number][] = [[0, 0], [-40, -24], [123, -456]];
+const GRID_SIZE = 48;
+const PYRAMID_LEVELS = 4;
+const CHUNKS: [number, number][] = [[0, 0], [-1, -1], [7, -3], [-20, 11]];
+const NOISE_SCALES = [0.005, 0.08];   // Terrain height and swamp patch scales
+// Far chunks included: the chunk seed is computed in double math
+const TREE_CHUNKS: [number, number][] = [[0, 0], [-1, -1], [7, -3], [-20, 11], [6250, -4375], [-100000, 99999]];
+const TREE_TYPE_COUNT = 9;
+
+// ChunkGenerator seeds are JS numbers
+const CHUNK_SEEDS = [0, 42, -1, 987654321];
+const CHUNKDATA_CHUNKS: [number, number][] = [[0, 0], [-1, -1], [5, -9], [-33, 17], [100, 100]];
+
+// Biome ID of swamp, the one synthetic table entry using the noise marker
+const GOLDEN_SWAMP_BIOME = 6;
+
+const FNV_OFFSET = 0xcbf29ce484222325n;
+const FNV_PRIME = 0x100000001b3n;
+const MASK_64 = 0xffffffffffffffffn;
+
+/**
+ * 64-bit FNV-1a, fed incrementally with bytes
+ */
+class Fnv1a {
+  private hash = FNV_OFFSET;
+  
+  bytes(data: Uint8Array): this {
+    let h = this.hash;
+    for (let i = 0; i < data.length; i++) {
+      h = ((h ^ BigInt(data[i])) * FNV_PRIME) & MASK_64;
+    }
+    this.hash = h;
+    return this;
+  }
+  
+  view(data: ArrayBufferView): this {
+    return this.bytes(new Uint8Array(data.buffer, data.byteOffset, data.byteLength));
+  }
+  
+  int32(value: number): this {
+    return this.view(new Int32Array([value]));
+  }
+  
+  string(value: string): this {
+    return this.bytes(new TextEncoder().encode(value));
+  }
+  
+  hex(): string {
+    return this.hash.toString(16).padStart(16, '0');
+  }
+}
+
+/**
+ * Hash a surface in native ChunkSurface byte order (all views are little-endian)
+ */
+function hashSurface(surface: ChunkSurface): string {
+  return new Fnv1a()
+    .view(surface.heightMap)
+    .view(surface.topBlock)
+    .view(surface.waterDepth)
+    .view(surface.rightNeighborHeights)
+    .view(surface.frontNeighborHeights)
+    .view(surface.biomeMap)
+    .hex();
+}
+
+function hashChunkData(data: ChunkData): string {
+  const hash = new Fnv1a()
+    .view(data.heightMap)
+    .view(data.biomeMap)
+    .view(data.topBlock)
+    .view(data.waterDepth)
+    .view(data.rightNeighborHeights)
+    .view(data.frontNeighborHeights)
+    .int32(data.trees.length);
+  
+  for (const tree of data.trees) {
+    hash.int32(tree.x).int32(tree.z).int32(tree.type).int32(tree.variant);
+  }
+  return hash.hex();
+}
+
+function syntheticSurfaceTable(): Uint8Array {
+  const table = new Uint8Array(256);
+  for (let i = 0; i < 256; i++) {
+    table[i] = i % 40;
+  }
+  table[GOLDEN_SWAMP_BIOME] = SURFACE_SWAMP;
+  return table;
+}
+
+/**
+ * Synthetic tree rules: every tree type, with and without a secondary type
+ */
+function syntheticTreeTable(): TreeRuleTable {
+  const table: TreeRuleTable = {
+    chance: new Float64Array(256),
+    density: new Uint8Array(256),
+    primary: new Uint8Array(256),
+    secondary: new Uint8Array(256),
+  };
+  for (let i = 0; i < 256; i++) {
+    table.chance[i] = 0.6;
+    table.density[i] = i % 12;
+    table.primary[i] = i % 10 === 9 ? TREE_NONE : i % TREE_TYPE_COUNT;
+    table.secondary[i] = i % 3 === 0 ? (i + 4) % TREE_TYPE_COUNT : TREE_NONE;
+  }
+  return table;
+}
+
+/**
+ * Synthetic tree input for a chunk (an LCG seeded from its coordinates),
+ * so placement is checked without cubiomes or the surface pass
+ */
+function syntheticTreeSurface(chunkX: number, chunkZ: number): ChunkSurface {
+  const cells = 16 * 16;
+  const surface: ChunkSurface = {
+    heightMap: new Uint8Array(cells),
+    biomeMap: new Uint8Array(cells),
+    topBlock: new Uint8Array(cells),
+    waterDepth: new Uint8Array(cells),
+    rightNeighborHeights: new Uint8Array(16),
+    frontNeighborHeights: new Uint8Array(16),
+  };
+  let r = (Math.imul(chunkX, 73856093) ^ Math.imul(chunkZ, 19349663)) >>> 0;
+  for (let i = 0; i < cells; i++) {
+    r = (Math.imul(r, 1664525) + 1013904223) >>> 0;
+    surface.heightMap[i] = 56 + (r >>> 24) % 24;
+    surface.topBlock[i] = (r >>> 16) % 11;
+    surface.biomeMap[i] = r >>> 8;
+  }
+  return surface;
+}
+
+/**
+ * Compute all digest lines ("<kind> <key=value...> fnv=<hex>")
+ */
+export async function computeDigests(): Promise<string[]> {
+  await loadCubiomesModule(false);
+  const lines: string[] = [];
+  
+  for (const minor of MINORS) {
+    for (const seed of SEEDS) {
+      const generator = new WasmGenerator(seed);
+      await generator.init(getNativeMcVersion(minor));
+      
+      try {
+        for (const scale of SCALES) {
+          for (const [x, z] of ORIGINS) {
+            const grid = generator.genBiomes2DView(scale, x, z, GRID_SIZE, GRID_SIZE, 63);
+            lines.push(`biomes mc=1.${minor} seed=${seed} scale=${scale} x=${x} z=${z} size=${GRID_SIZE} fnv=${new Fnv1a().view(grid).hex()}`);
+          }
+        }
+        
+        // Origins are in scale-4 cells here
+        for (const [x, z] of ORIGINS) {
+          const levels = generator.genBiomePyramid(x, z, GRID_SIZE, GRID_SIZE, PYRAMID_LEVELS);
+          levels.forEach((level, index) => {
+            lines.push(`pyramid mc=1.${minor} seed=${seed} level=${index} x=${x} z=${z} size=${GRID_SIZE} fnv=${new Fnv1a().view(level.biomes).hex()}`);
+          });
+        }
+        
+        // Native side truncates the seed to int for the surface noise
+        generator.configureSurface(Number(BigInt.asIntN(32, seed)), syntheticSurfaceTable());
+        for (const [cx, cz] of CHUNKS) {
+          const surface = generator.genChunkSurface(cx, cz);
+          lines.push(`surface mc=1.${minor} seed=${seed} cx=${cx} cz=${cz} fnv=${hashSurface(surface)}`);
+        }
+      } finally {
+        generator.destroy();
+      }
+    }
+  }
+  
+  // Surface noise does not depend on the version: one generator per seed
+  for (const seed of SEEDS) {
+    const generator = new WasmGenerator(seed);
+    await generator.init(getNativeMcVersion(20));
+    
+    try {
+      generator.configureSurface(Number(BigInt.asIntN(32, seed)), syntheticSurfaceTable());
+      for (const field of [NoiseField.TERRAIN, NoiseField.SWAMP]) {
+        for (const scale of NOISE_SCALES) {
+          for (const [x, z] of ORIGINS) {
+            const grid = generator.genNoiseGrid(field, x, z, GRID_SIZE, GRID_SIZE, scale);
+            lines.push(`noise seed=${seed} field=${field} scale=${scale} x=${x} z=${z} size=${GRID_SIZE} fnv=${new Fnv1a().view(grid).hex()}`);
+          }
+        }
+      }
+    } finally {
+      generator.destroy();
+    }
+  }
+  
+  // Tree placement: positions and types, on synthetic input
+  for (const seed of SEEDS) {
+    const generator = new WasmGenerator(seed);
+    await generator.init(getNativeMcVersion(20));
+    
+    try {
+      generator.configureSurface(Number(BigInt.asIntN(32, seed)), syntheticSurfaceTable());
+      generator.configureTrees(syntheticTreeTable());
+      for (const [cx, cz] of TREE_CHUNKS) {
+        const trees = generator.genChunkTrees(cx, cz, syntheticTreeSurface(cx, cz));
+        const hash = new Fnv1a().int32(trees.length);
+        for (const tree of trees) {
+          hash.int32(tree.x).int32(tree.z).int32(tree.type);
+        }
+        lines.push(`trees seed=${seed} cx=${cx} cz=${cz} fnv=${hash.hex()}`);
+        
+        // Shape choice, kept apart so a shape change doesn't hide a placement change
+        const variants = new Fnv1a().int32(trees.length);
+        for (const tree of trees) {
+          variants.int32(tree.variant);
+        }
+        lines.push(`variants seed=${seed} cx=${cx} cz=${cz} fnv=${variants.hex()}`);
+      }
+    } finally {
+      generator.destroy();
+    }
+  }
+  
+  // Tree shapes, per type: trunk height, then blocks, of every variant in order
+  const templates = getTreeTemplates();
+  for (let type = 0; type < TREE_TYPE_COUNT; type++) {
+    const hash = new Fnv1a();
+    for (let variant = 0; variant < TREE_VARIANTS; variant++) {
+      const i = type * TREE_VARIANTS + variant;
+      const start = templates.start[i];
+      hash.int32(templates.height[i]).int32(templates.count[i]);
+      hash.view(templates.blocks.subarray(start, start + templates.count[i]));
+    }
+    lines.push(`templates type=${type} variants=${TREE_VARIANTS} fnv=${hash.hex()}`);
+  }
+  
+  for (const seed of CHUNK_SEEDS) {
+    const generator = new ChunkGenerator(seed);
+    await generator.init();
+    for (const [cx, cz] of CHUNKDATA_CHUNKS) {
+      const data = generator.generateChunk(cx, cz);
+      lines.push(`chunkdata seed=${seed} cx=${cx} cz=${cz} fnv=${hashChunkData(data)}`);
+    }
+  }
+  
+  return lines;
+}
+
+/**
+ * Result of comparing digests with a golden file
+ */
+export interface DigestComparison {
+  checked: number;
+  mismatches: string[];   // Human-readable, empty if everything matched
+  unrecorded: number;     // Digests with no line in the golden file
+  unrecordedKinds: string[];   // Kinds with no golden line at all (these fail)
+}
+
+/**
+ * Kind of a digest line (its first word)
+ */
+export function digestKind(line: string): string {
+  const space = line.indexOf(' ');
+  return space < 0 ? line : line.slice(0, space);
+}
+
+/**
+ * Compare digest lines against a golden file's contents
+ * Lines starting with '#' are comments. Single digests the file has no line
+ * for are counted, not failed (a matrix entry can be added before it is
+ * recorded), but a kind with no golden lines at all is a failure.
+ */
+export function compareDigests(actual: string[], golden: string): DigestComparison {
+  const split = (line: string): [string, string] | null => {
+    const at = line.lastIndexOf(' fnv=');
+    return at < 0 ? null : [line.slice(0, at), line.slice(at + 5).trim()];
+  };
+  
+  const expected = new Map<string, string>();
+  const goldenKinds = new Set<string>();
+  for (const line of golden.split('\n')) {
+    if (line.startsWith('#')) continue;
+    const parts = split(line);
+    if (!parts) continue;
+    expected.set(parts[0], parts[1]);
+    goldenKinds.add(digestKind(line));
+  }
+  
+  const mismatches: string[] = [];
+  const unrecordedKinds: string[] = [];
+  let checked = 0;
+  let unrecorded = 0;
+  for (const line of actual) {
+    const parts = split(line);
+    if (!parts) continue;
+    
+    const kind = digestKind(line);
+    if (!goldenKinds.has(kind) && !unrecordedKinds.includes(kind)) {
+      unrecordedKinds.push(kind);
+    }
+    const want = expected.get(parts[0]);
+    if (want === undefined) {
+      unrecorded++;
+      continue;
+    }
+    
+    checked++;
+    if (want !== parts[1]) {
+      mismatches.push(`${parts[0]}: expected ${want}, got ${parts[1]}`);
+    }
+  }
+  
+  if (checked === 0) {
+    mismatches.push('No digests in common with the golden file');
+  }
+  return { checked, mismatches, unrecorded, unrecordedKinds };
+}
+
+/**
+ * Run the full check and log the result
+ * @param golden - Contents of the golden file (e.g. fetched or read from disk)
+ */
+export async function runDeterminismCheck(golden: string): Promise<boolean> {
+  console.log('🔁 Computing determinism digests...');
+  const { checked, mismatches, unrecorded, unrecordedKinds } = compareDigests(await computeDigests(), golden);
+  
+  if (unrecorded > 0) {
+    console.log(`ℹ️ ${unrecorded} digests have no golden line (not checked)`);
+  }
+  for (const kind of unrecordedKinds) {
+    console.error(`❌ Kind "${kind}" has no golden lines, so nothing of it is checked`);
+  }
+  if (mismatches.length === 0 && unrecordedKinds.length === 0) {
+    console.log(`✅ All ${checked} digests match`);
+    return true;
+  }
+  for (const mismatch of mismatches) {
+    console.error(`❌ ${mismatch}`);
+  }
+  return false;
+}
@@ -4,10 +4,21 @@
  */
 
 import * as THREE from 'three';
-import { CHUNK_SIZE, BlockType, TreeTypeToLogBlockType, TreeTypeToLeavesBlockType } from '../world/types';
+import { CHUNK_SIZE, BlockType, TreeType, TreeTypeToLogBlockType, TreeTypeToLeavesBlockType } from '../world/types';
 import type { ChunkGenerator, ChunkData } from '../world/ChunkGenerator';
+import {
+  TreeBlockKind,
+  getTreeTemplate,
+  treeBlockDx,
+  treeBlockDy,
+  treeBlockDz,
+  treeBlockKind,
+} from '../world/vegetation/TreeGenerator';
 import { TextureManager3D } from './TextureManager3D';
 import { FallingBlockManager } from './FallingBlock';
+import { ChunkWorkerClient } from './ChunkWorkerClient';
+import { ChunkTable } from './ChunkTable';
+import { WasmVoxelStore, VOXEL_NONE } from '../cubiomes/wasm-bindings';
 import {
   getBlockDef,
   getUndergroundLayers,
@@ -20,6 +31,7 @@ import {
 
 const DEFAULT_LOAD_RADIUS = 3;   // Reduced from 4 for performance (49 vs 81 chunks)
 const DEFAULT_UNLOAD_RADIUS = 5; // Default chunks to unload beyond this
+const MAX_BACKGROUND_CHUNKS_PER_FRAME = 4; // Meshes built per frame from background generation
 
 // Reusable geometry for blocks
 const blockGeometry = new THREE.BoxGeometry(1, 1, 1);
@@ -258,19 +270,92 @@ enum TreeLOD {
   Hidden = 2,    // No trees at all
 }
 
+/**
+ * Tree blocks of one chunk by position, built when the chunk loads so
+ * block queries index an array instead of walking every tree template
+ * Covers only the chunk's own columns, between the lowest and highest
+ * tree block. Where trees overlap, the first tree in data.trees wins.
+ */
+interface TreeBlockIndex {
+  minY: number;
+  levels: number;
+  blocks: Uint8Array;  // BlockType at ((y - minY) * CHUNK_SIZE + lz) * CHUNK_SIZE + lx, 0 = none
+}
+
+/**
+ * Index a chunk's tree blocks (null if it has none)
+ */
+function buildTreeBlockIndex(data: ChunkData): TreeBlockIndex | null {
+  if (!data.trees || data.trees.length === 0) return null;
+  
+  // First pass: height range of the blocks inside the chunk
+  let minY = Infinity;
+  let maxY = -Infinity;
+  for (const tree of data.trees) {
+    const baseY = data.heightMap[tree.z * CHUNK_SIZE + tree.x] + 1;
+    const template = getTreeTemplate(tree.type, tree.variant);
+    for (let i = 0; i < template.length; i++) {
+      const record = template[i];
+      const lx = tree.x + treeBlockDx(record);
+      const lz = tree.z + treeBlockDz(record);
+      if (lx < 0 || lx >= CHUNK_SIZE || lz < 0 || lz >= CHUNK_SIZE) continue;
+      const y = baseY + treeBlockDy(record);
+      if (y < minY) minY = y;
+      if (y > maxY) maxY = y;
+    }
+  }
+  if (minY > maxY) return null;
+  
+  const levels = maxY - minY + 1;
+  const blocks = new Uint8Array(levels * CHUNK_SIZE * CHUNK_SIZE);
+  for (const tree of data.trees) {
+    const baseY = data.heightMap[tree.z * CHUNK_SIZE + tree.x] + 1;
+    const logBlock = TreeTypeToLogBlockType[tree.type];
+    const leavesBlock = TreeTypeToLeavesBlockType[tree.type];
+    const template = getTreeTemplate(tree.type, tree.variant);
+    for (let i = 0; i < template.length; i++) {
+      const record = template[i];
+      const lx = tree.x + treeBlockDx(record);
+      const lz = tree.z + treeBlockDz(record);
+      if (lx < 0 || lx >= CHUNK_SIZE || lz < 0 || lz >= CHUNK_SIZE) continue;
+      
+      const idx = ((baseY + treeBlockDy(record) - minY) * CHUNK_SIZE + lz) * CHUNK_SIZE + lx;
+      if (blocks[idx] !== 0) continue;
+      
+      const kind = treeBlockKind(record);
+      blocks[idx] = kind === TreeBlockKind.Log ? logBlock
+        : kind === TreeBlockKind.Leaves ? leavesBlock
+        : BlockType.Cactus;
+    }
+  }
+  return { minY, levels, blocks };
+}
+
+/**
+ * A loaded chunk: its scene group and everything block queries read
+ */
+interface LoadedChunk {
+  group: THREE.Group;   // Terrain and trees
+  data: ChunkData;
+  trees: TreeBlockIndex | null;   // null if the chunk has no tree blocks
+}
+
 export class ChunkManager3D {
   private scene: THREE.Scene;
   private generator: ChunkGenerator;
   private textureManager: TextureManager3D;
   
-  private chunks: Map<string, THREE.Group> = new Map();
-  private chunkData: Map<string, ChunkData> = new Map();
+  private chunks = new ChunkTable<LoadedChunk>();
   
-  // Track broken blocks so they don't reappear on chunk reload
-  private brokenBlocks: Map<string, Set<string>> = new Map(); // chunkKey -> Set of "x,y,z"
+  // Chunks queued for background generation and not yet received
+  private pendingChunks = new ChunkTable<true>();
   
-  // Track player-placed blocks: chunkKey -> Map of "x,y,z" -> BlockType
-  private placedBlocks: Map<string, Map<string, BlockType>> = new Map();
+  // Generation worker, used when the WASM build has no native worker threads
+  private chunkWorker: ChunkWorkerClient | null = null;
+  
+  // Block edits, kept across chunk reloads: BlockType.Air where a block
+  // was broken, the block's type where the player placed one
+  private edits = new WasmVoxelStore();
   
   // Track door states: "x,y,z" -> { open: boolean, facing: number (0-3 for N/E/S/W) }
   private doorStates: Map<string, { open: boolean; facing: number }> = new Map();
@@ -305,6 +390,10 @@ export class ChunkManager3D {
     this.generator = generator;
     this.textureManager = textureManager;
     
+    if (!generator.hasBackgroundGeneration() && ChunkWorkerClient.isSupported()) {
+      this.chunkWorker = new ChunkWorkerClient(generator.getSeed());
+    }
+    
     // Initialize falling block manager
     this.fallingBlockManager = new FallingBlockManager(
       scene,
@@ -428,6 +517,18 @@ export class ChunkManager3D {
     const chunkX = Math.floor(playerX / CHUNK_SIZE);
     const chunkZ = Math.floor(playerZ / CHUNK_SIZE);
     
+    // Pick up chunks finished in the background since the last frame
+    if (this.pendingChunks.size > 0) {
+      this.receiveBackgroundChunks();
+    }
+    
+    // A dead worker never delivers its pending chunks: rescan and generate them here
+    if (this.chunkWorker?.hasFailed()) {
+      this.chunkWorker = null;
+      this.pendingChunks.clear();
+      this.lastPlayerChunkX = this.lastPlayerChunkZ = -999;
+    }
+    
     // Only update if player moved to a new chunk
     if (chunkX === this.lastPlayerChunkX && chunkZ === this.lastPlayerChunkZ) {
       return;
@@ -436,29 +537,51 @@ export class ChunkManager3D {
     this.lastPlayerChunkX = chunkX;
     this.lastPlayerChunkZ = chunkZ;
     
-    // Load nearby chunks
+    // Collect missing chunks in the load square (and their bounding box)
+    const missing: Array<[number, number]> = [];
+    let minCX = Infinity, minCZ = Infinity, maxCX = -Infinity, maxCZ = -Infinity;
     for (let dx = -this.loadRadius; dx <= this.loadRadius; dx++) {
       for (let dz = -this.loadRadius; dz <= this.loadRadius; dz++) {
         const cx = chunkX + dx;
         const cz = chunkZ + dz;
-        const key = `${cx},${cz}`;
         
-        if (!this.chunks.has(key)) {
-          this.loadChunk(cx, cz);
+        if (!this.chunks.has(cx, cz) && !this.pendingChunks.has(cx, cz)) {
+          missing.push([cx, cz]);
+          minCX = Math.min(minCX, cx);
+          minCZ = Math.min(minCZ, cz);
+          maxCX = Math.max(maxCX, cx);
+          maxCZ = Math.max(maxCZ, cz);
         }
       }
     }
     
+    // Load nearby chunks: in the background when the generator has worker
+    // threads, otherwise generated here as batched regions
+    if (missing.length > 0) {
+      if (this.hasBackgroundGeneration()) {
+        this.requestMissingChunks(missing, chunkX, chunkZ);
+      } else {
+        this.loadMissingChunks(missing, minCX, minCZ, maxCX, maxCZ);
+      }
+    }
+    
+    // Cancel background requests that left the load square
+    this.pendingChunks.forEach((_, cx, cz) => {
+      if (Math.abs(cx - chunkX) > this.loadRadius || Math.abs(cz - chunkZ) > this.loadRadius) {
+        this.chunkWorker?.cancel(cx, cz);
+        this.pendingChunks.delete(cx, cz);
+      }
+    });
+    
     // Unload distant chunks
-    for (const [key, group] of this.chunks) {
-      const [cx, cz] = key.split(',').map(Number);
+    this.chunks.forEach((chunk, cx, cz) => {
       const dx = Math.abs(cx - chunkX);
       const dz = Math.abs(cz - chunkZ);
       
       if (dx > this.unloadRadius || dz > this.unloadRadius) {
-        this.unloadChunk(key, group);
+        this.unloadChunk(cx, cz, chunk);
       }
-    }
+    });
   }
   
   /**
@@ -484,18 +607,112 @@ export class ChunkManager3D {
   }
 
   /**
-   * Load a chunk
+   * Generate and load missing chunks with as few native biome passes as possible
+   * The whole bounding box is one region when the missing chunks fill most of it
+   * (first load, teleports); otherwise (a strip after a boundary crossing) each
+   * row's contiguous run is its own region so we don't generate loaded chunks again.
    */
-  private loadChunk(chunkX: number, chunkZ: number): void {
-    const key = `${chunkX},${chunkZ}`;
+  private loadMissingChunks(
+    missing: Array<[number, number]>,
+    minCX: number,
+    minCZ: number,
+    maxCX: number,
+    maxCZ: number
+  ): void {
+    const isMissing = (cx: number, cz: number) => !this.chunks.has(cx, cz);
+    const countX = maxCX - minCX + 1;
+    const countZ = maxCZ - minCZ + 1;
     
-    // Generate chunk data
-    const data = this.generator.generateChunk(chunkX, chunkZ);
-    this.chunkData.set(key, data);
+    if (countX * countZ <= missing.length * 2) {
+      for (const chunk of this.generator.generateRegion(minCX, minCZ, countX, countZ, isMissing)) {
+        this.loadChunk(chunk.chunkX, chunk.chunkZ, chunk.data);
+      }
+      return;
+    }
+    
+    // Group into contiguous runs per row
+    missing.sort((a, b) => (a[1] - b[1]) || (a[0] - b[0]));
+    let runStart = 0;
+    for (let i = 1; i <= missing.length; i++) {
+      const prev = missing[i - 1];
+      const cur = missing[i];
+      if (cur && cur[1] === prev[1] && cur[0] === prev[0] + 1) continue;
+      
+      const [startX, rowZ] = missing[runStart];
+      for (const chunk of this.generator.generateRegion(startX, rowZ, prev[0] - startX + 1, 1)) {
+        this.loadChunk(chunk.chunkX, chunk.chunkZ, chunk.data);
+      }
+      runStart = i;
+    }
+  }
+
+  /**
+   * Whether chunks are generated off the main thread (native threads or worker)
+   */
+  private hasBackgroundGeneration(): boolean {
+    return this.generator.hasBackgroundGeneration() || (this.chunkWorker?.isReady() ?? false);
+  }
+
+  /**
+   * Queue a chunk with whichever background generator is available
+   */
+  private requestBackgroundChunk(chunkX: number, chunkZ: number): boolean {
+    if (this.chunkWorker?.isReady()) {
+      return this.chunkWorker.request(chunkX, chunkZ);
+    }
+    return this.generator.requestChunk(chunkX, chunkZ);
+  }
+
+  /**
+   * Queue missing chunks for background generation
+   * The player's own chunk is generated right away so there is always ground
+   * underfoot; chunks the queue can't take are generated here as well.
+   */
+  private requestMissingChunks(missing: Array<[number, number]>, playerChunkX: number, playerChunkZ: number): void {
+    for (const [cx, cz] of missing) {
+      if (cx === playerChunkX && cz === playerChunkZ) {
+        this.loadChunk(cx, cz);
+      } else if (this.requestBackgroundChunk(cx, cz)) {
+        this.pendingChunks.set(cx, cz, true);
+      } else {
+        this.loadChunk(cx, cz);
+      }
+    }
+  }
+
+  /**
+   * Load chunks that finished generating in the background
+   * A bounded number per frame keeps mesh building from stalling a frame.
+   * Chunks that left the load square while in flight are dropped.
+   */
+  private receiveBackgroundChunks(): void {
+    const received = this.chunkWorker
+      ? this.chunkWorker.poll(MAX_BACKGROUND_CHUNKS_PER_FRAME)
+      : this.generator.pollGeneratedChunks(MAX_BACKGROUND_CHUNKS_PER_FRAME);
     
+    for (const chunk of received) {
+      this.pendingChunks.delete(chunk.chunkX, chunk.chunkZ);
+      
+      if (this.chunks.has(chunk.chunkX, chunk.chunkZ)) continue;
+      if (Math.abs(chunk.chunkX - this.lastPlayerChunkX) > this.loadRadius ||
+          Math.abs(chunk.chunkZ - this.lastPlayerChunkZ) > this.loadRadius) {
+        continue;
+      }
+      
+      this.loadChunk(chunk.chunkX, chunk.chunkZ, chunk.data);
+    }
+  }
+
+  /**
+   * Load a chunk
+   * @param data - Pre-generated chunk data (e.g. from a region pass); generated here if omitted
+   */
+  private loadChunk(chunkX: number, chunkZ: number, data: ChunkData = this.generator.generateChunk(chunkX, chunkZ)): void {
     // Create chunk group (contains both terrain and trees for proper raycasting)
     const group = new THREE.Group();
-    group.name = `chunk_${key}`;
+    group.name = `chunk_${chunkX},${chunkZ}`;
+    
+    this.chunks.set(chunkX, chunkZ, { group, data, trees: buildTreeBlockIndex(data) });
     
     // World position offset
     const worldX = chunkX * CHUNK_SIZE;
@@ -510,7 +727,6 @@ export class ChunkManager3D {
     
     // Add to scene
     this.scene.add(group);
-    this.chunks.set(key, group);
   }
 
   /**
@@ -525,7 +741,6 @@ export class ChunkManager3D {
   ): void {
     const chunkX = Math.floor(worldX / CHUNK_SIZE);
     const chunkZ = Math.floor(worldZ / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
     
     // Group blocks by type AND biome (for blocks that need biome tinting)
     // Key format: "blockType" or "blockType_biome" for tinted blocks
@@ -593,20 +808,15 @@ export class ChunkManager3D {
       }
     }
     
-    // Add placed blocks
-    const placedMap = this.placedBlocks.get(chunkKey);
-    if (placedMap) {
-      for (const [posKey, blockType] of placedMap) {
-        const [x, y, z] = posKey.split(',').map(Number);
-        // Use a default biome (plains = 1) for placed blocks
-        // TODO: Could get actual biome from nearby terrain
-        const lx = ((x % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
-        const lz = ((z % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
-        const idx = lz * CHUNK_SIZE + lx;
-        const biome = data.biomeMap[idx] || 1;
-        
-        addBlock(x, y, z, blockType, biome);
-      }
+    // Add placed blocks (records: local x, local z, y, block type)
+    for (const record of this.edits.chunkBlocks(chunkX, chunkZ, BlockType.Air)) {
+      const lx = record & 0xF;
+      const lz = (record >>> 4) & 0xF;
+      // Use a default biome (plains = 1) for placed blocks
+      // TODO: Could get actual biome from nearby terrain
+      const biome = data.biomeMap[lz * CHUNK_SIZE + lx] || 1;
+      
+      addBlock(worldX + lx, (record >>> 8) & 0xFF, worldZ + lz, record >>> 16, biome);
     }
     
     // Create instanced meshes for each block type/biome combination
@@ -794,10 +1004,19 @@ export class ChunkManager3D {
       const baseY = groundHeight + 1;
       const baseZ = worldZ + tree.z;
       
+      // Shared shape: broken blocks are skipped here, not removed from it
+      const template = getTreeTemplate(tree.type, tree.variant);
+      
       // Special handling for cacti - create a single merged geometry (no internal faces = no Z-fighting seams)
-      if (tree.blocks && tree.blocks.length > 0 && tree.blocks[0].type === 'cactus') {
+      if (tree.type === TreeType.Cactus) {
         // Count cactus blocks to determine height
-        const cactusHeight = tree.blocks.filter(b => b.type === 'cactus').length;
+        let cactusHeight = 0;
+        for (let i = 0; i < template.length; i++) {
+          const record = template[i];
+          if (treeBlockKind(record) !== TreeBlockKind.Cactus) continue;
+          if (this.isBlockBroken(baseX, baseY + treeBlockDy(record), baseZ)) continue;
+          cactusHeight++;
+        }
         if (cactusHeight > 0) {
           // Use material array with tiled side texture and separate top texture
           const cactusMaterials = this.textureManager.getCactusMaterials();
@@ -818,30 +1037,33 @@ export class ChunkManager3D {
       }
       
       // Collect blocks for batching (non-cactus trees)
-      if (tree.blocks) {
-        for (const block of tree.blocks) {
-          const blockX = baseX + block.dx;
-          const blockY = baseY + block.dy;
-          const blockZ = baseZ + block.dz;
-          
-          // Create unique key for this position
-          const posKey = `${blockX},${blockY},${blockZ}`;
-          
-          // Skip if block already placed at this position
-          if (placedBlocks.has(posKey)) continue;
-          placedBlocks.add(posKey);
-          
-          if (block.type === 'leaves') {
-            // Batch leaves by type and biome
-            const batchKey = `${leavesType}_${biome}`;
-            if (!leavesBatches.has(batchKey)) {
-              leavesBatches.set(batchKey, []);
-            }
-            leavesBatches.get(batchKey)!.push(new THREE.Vector3(blockX, blockY, blockZ));
-          } else if (block.type === 'log') {
-            // Collect logs for individual mesh creation
-            logPositions.push({ pos: new THREE.Vector3(blockX, blockY, blockZ), logType });
+      for (let i = 0; i < template.length; i++) {
+        const record = template[i];
+        const kind = treeBlockKind(record);
+        if (kind !== TreeBlockKind.Leaves && kind !== TreeBlockKind.Log) continue;
+        
+        const blockX = baseX + treeBlockDx(record);
+        const blockY = baseY + treeBlockDy(record);
+        const blockZ = baseZ + treeBlockDz(record);
+        
+        // Create unique key for this position
+        const posKey = `${blockX},${blockY},${blockZ}`;
+        
+        // Skip if block already placed at this position, or broken
+        if (placedBlocks.has(posKey)) continue;
+        if (this.isBlockBroken(blockX, blockY, blockZ)) continue;
+        placedBlocks.add(posKey);
+        
+        if (kind === TreeBlockKind.Leaves) {
+          // Batch leaves by type and biome
+          const batchKey = `${leavesType}_${biome}`;
+          if (!leavesBatches.has(batchKey)) {
+            leavesBatches.set(batchKey, []);
           }
+          leavesBatches.get(batchKey)!.push(new THREE.Vector3(blockX, blockY, blockZ));
+        } else {
+          // Collect logs for individual mesh creation
+          logPositions.push({ pos: new THREE.Vector3(blockX, blockY, blockZ), logType });
         }
       }
     }
@@ -920,18 +1142,17 @@ export class ChunkManager3D {
   /**
    * Unload a chunk
    */
-  private unloadChunk(key: string, group: THREE.Group): void {
-    this.scene.remove(group);
+  private unloadChunk(chunkX: number, chunkZ: number, chunk: LoadedChunk): void {
+    this.scene.remove(chunk.group);
     
     // Dispose of geometries and materials
-    group.traverse((child) => {
+    chunk.group.traverse((child) => {
       if (child instanceof THREE.Mesh) {
         // Don't dispose shared geometry/materials
       }
     });
     
-    this.chunks.delete(key);
-    this.chunkData.delete(key);
+    this.chunks.delete(chunkX, chunkZ);
   }
 
   /**
@@ -945,11 +1166,10 @@ export class ChunkManager3D {
     
     const chunkX = Math.floor(floorX / CHUNK_SIZE);
     const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const key = `${chunkX},${chunkZ}`;
     
     // Get terrain height from heightmap
     let terrainHeight = 64; // Default
-    const data = this.chunkData.get(key);
+    const data = this.chunks.get(chunkX, chunkZ)?.data;
     if (data) {
       const lx = ((floorX % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
       const lz = ((floorZ % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
@@ -964,20 +1184,8 @@ export class ChunkManager3D {
       terrainHeight = (height === undefined || isNaN(height)) ? 64 : Math.floor(height);
     }
     
-    // Check for placed blocks at this x,z position
-    const placedMap = this.placedBlocks.get(key);
-    let highestPlaced = -Infinity;
-    if (placedMap && placedMap.size > 0) {
-      console.log(`[getHeightAt] Checking placedMap for chunk ${key}, size=${placedMap.size}`);
-      for (const posKey of placedMap.keys()) {
-        const [px, py, pz] = posKey.split(',').map(Number);
-        console.log(`[getHeightAt] Placed block at ${posKey}: px=${px}, py=${py}, pz=${pz}, floorX=${floorX}, floorZ=${floorZ}`);
-        if (px === floorX && pz === floorZ && py > highestPlaced) {
-          highestPlaced = py;
-          console.log(`[getHeightAt] Found matching placed block at y=${py}`);
-        }
-      }
-    }
+    // Highest placed block at this x,z position (VOXEL_NONE if none)
+    const highestPlaced = this.edits.columnTop(floorX, floorZ, BlockType.Air);
     
     // Start scanning from the maximum of terrain surface or highest placed block
     const startY = Math.max(terrainHeight, highestPlaced);
@@ -986,7 +1194,7 @@ export class ChunkManager3D {
     // Scan down from top to find the first solid block
     for (let y = startY; y >= endY; y--) {
       // Check if there's a placed block at this level
-      if (placedMap && placedMap.has(`${floorX},${y},${floorZ}`)) {
+      if (this.getPlacedBlock(floorX, y, floorZ) !== null) {
         return y;
       }
       
@@ -1017,11 +1225,10 @@ export class ChunkManager3D {
     
     const chunkX = Math.floor(floorX / CHUNK_SIZE);
     const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const key = `${chunkX},${chunkZ}`;
     
     // Get base terrain height
     let terrainHeight = 64;
-    const data = this.chunkData.get(key);
+    const data = this.chunks.get(chunkX, chunkZ)?.data;
     if (data) {
       const lx = ((floorX % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
       const lz = ((floorZ % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
@@ -1074,15 +1281,11 @@ export class ChunkManager3D {
     
     const chunkX = Math.floor(floorX / CHUNK_SIZE);
     const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const key = `${chunkX},${chunkZ}`;
     
     // Check placed blocks first
-    const placedMap = this.placedBlocks.get(key);
-    if (placedMap && placedMap.has(`${floorX},${floorY},${floorZ}`)) {
-      const blockType = placedMap.get(`${floorX},${floorY},${floorZ}`);
-      if (blockType !== BlockType.Water && blockType !== BlockType.Air) {
-        return true;
-      }
+    const placedBlock = this.getPlacedBlock(floorX, floorY, floorZ);
+    if (placedBlock !== null && placedBlock !== BlockType.Water) {
+      return true;
     }
     
     // Check if it's broken
@@ -1091,7 +1294,7 @@ export class ChunkManager3D {
     }
     
     // Check terrain blocks
-    const data = this.chunkData.get(key);
+    const data = this.chunks.get(chunkX, chunkZ)?.data;
     if (data) {
       const lx = ((floorX % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
       const lz = ((floorZ % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
@@ -1149,7 +1352,6 @@ export class ChunkManager3D {
     
     const chunkX = Math.floor(floorX / CHUNK_SIZE);
     const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const key = `${chunkX},${chunkZ}`;
     
     // First check placed blocks
     const placedBlock = this.getPlacedBlock(floorX, floorY, floorZ);
@@ -1162,8 +1364,9 @@ export class ChunkManager3D {
       return BlockType.Air;
     }
     
-    const data = this.chunkData.get(key);
-    if (!data) return null;
+    const chunk = this.chunks.get(chunkX, chunkZ);
+    if (!chunk) return null;
+    const data = chunk.data;
     
     const lx = ((floorX % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
     const lz = ((floorZ % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
@@ -1172,36 +1375,9 @@ export class ChunkManager3D {
     const surfaceHeight = Math.floor(data.heightMap[idx]);
     
     // Check tree blocks (leaves, logs, cacti)
-    if (data.trees) {
-      const worldX = chunkX * CHUNK_SIZE;
-      const worldZ = chunkZ * CHUNK_SIZE;
-      
-      for (const tree of data.trees) {
-        const treeIdx = tree.z * CHUNK_SIZE + tree.x;
-        const groundHeight = data.heightMap[treeIdx];
-        const baseX = worldX + tree.x;
-        const baseY = groundHeight + 1;
-        const baseZ = worldZ + tree.z;
-        
-        if (tree.blocks) {
-          for (const block of tree.blocks) {
-            const blockX = baseX + block.dx;
-            const blockY = baseY + block.dy;
-            const blockZ = baseZ + block.dz;
-            
-            if (blockX === floorX && blockY === floorY && blockZ === floorZ) {
-              // Found a tree block at this position
-              if (block.type === 'leaves') {
-                return TreeTypeToLeavesBlockType[tree.type];
-              } else if (block.type === 'log') {
-                return TreeTypeToLogBlockType[tree.type];
-              } else if (block.type === 'cactus') {
-                return BlockType.Cactus;
-              }
-            }
-          }
-        }
-      }
+    const treeBlock = this.getTreeBlockAt(chunk, lx, floorY, lz);
+    if (treeBlock !== null) {
+      return treeBlock;
     }
     
     // Check terrain block at surface level
@@ -1258,24 +1434,12 @@ export class ChunkManager3D {
     // Get chunk coordinates
     const chunkX = Math.floor(floorX / CHUNK_SIZE);
     const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
-    const posKey = `${floorX},${floorY},${floorZ}`;
     
-    // Check if this is a placed block - if so, remove from placedBlocks
-    const placedMap = this.placedBlocks.get(chunkKey);
-    if (placedMap && placedMap.has(posKey)) {
-      placedMap.delete(posKey);
-      // Don't add to brokenBlocks since it was player-placed, not terrain
-    } else {
-      // Track this terrain/tree block as broken
-      if (!this.brokenBlocks.has(chunkKey)) {
-        this.brokenBlocks.set(chunkKey, new Set());
-      }
-      this.brokenBlocks.get(chunkKey)!.add(posKey);
-    }
+    // Placed or generated, the block is air from now on
+    this.edits.set(floorX, floorY, floorZ, BlockType.Air);
     
     // Get chunk data
-    const data = this.chunkData.get(chunkKey);
+    const data = this.chunks.get(chunkX, chunkZ)?.data;
     if (!data) return null;
     
     // Calculate local coordinates
@@ -1290,30 +1454,8 @@ export class ChunkManager3D {
       data.topBlock[idx] = BlockType.Air;
     }
     
-    // Remove from trees if it's a tree block
-    if (data.trees) {
-      for (const tree of data.trees) {
-        if (!tree.blocks) continue;
-        
-        const treeBaseX = chunkX * CHUNK_SIZE + tree.x;
-        const treeBaseZ = chunkZ * CHUNK_SIZE + tree.z;
-        const treeIdx = tree.z * CHUNK_SIZE + tree.x;
-        const treeBaseY = Math.floor(data.heightMap[treeIdx]) + 1;
-        
-        // Find and remove matching block
-        for (let i = tree.blocks.length - 1; i >= 0; i--) {
-          const block = tree.blocks[i];
-          const blockX = treeBaseX + block.dx;
-          const blockY = treeBaseY + block.dy;
-          const blockZ = treeBaseZ + block.dz;
-          
-          if (blockX === floorX && blockY === floorY && blockZ === floorZ) {
-            tree.blocks.splice(i, 1);
-            break;
-          }
-        }
-      }
-    }
+    // Tree blocks need no update: trees share their shapes, and the
+    // Air edit above hides the block from meshing and lookups
     
     // Rebuild chunk mesh
     this.rebuildChunk(chunkX, chunkZ);
@@ -1329,15 +1471,13 @@ export class ChunkManager3D {
    * Rebuild a chunk's mesh (after block modification)
    */
   private rebuildChunk(chunkX: number, chunkZ: number): void {
-    const key = `${chunkX},${chunkZ}`;
-    const data = this.chunkData.get(key);
-    const oldGroup = this.chunks.get(key);
-    
-    if (!data || !oldGroup) return;
+    const chunk = this.chunks.get(chunkX, chunkZ);
+    if (!chunk) return;
+    const data = chunk.data;
     
     // Remove old chunk from scene
-    this.scene.remove(oldGroup);
-    oldGroup.traverse((child) => {
+    this.scene.remove(chunk.group);
+    chunk.group.traverse((child) => {
       if (child instanceof THREE.Mesh) {
         // Don't dispose shared geometries
       }
@@ -1345,7 +1485,8 @@ export class ChunkManager3D {
     
     // Create new chunk group (contains both terrain and trees)
     const group = new THREE.Group();
-    group.name = `chunk_${key}`;
+    group.name = `chunk_${chunkX},${chunkZ}`;
+    chunk.group = group;
     
     // World position offset
     const worldX = chunkX * CHUNK_SIZE;
@@ -1359,21 +1500,13 @@ export class ChunkManager3D {
     
     // Add to scene
     this.scene.add(group);
-    this.chunks.set(key, group);
   }
   
   /**
    * Check if a specific position has been marked as broken
    */
   isBlockBroken(x: number, y: number, z: number): boolean {
-    const chunkX = Math.floor(x / CHUNK_SIZE);
-    const chunkZ = Math.floor(z / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
-    
-    const brokenSet = this.brokenBlocks.get(chunkKey);
-    if (!brokenSet) return false;
-    
-    return brokenSet.has(`${Math.floor(x)},${Math.floor(y)},${Math.floor(z)}`);
+    return this.edits.get(Math.floor(x), Math.floor(y), Math.floor(z)) === BlockType.Air;
   }
 
   /**
@@ -1394,23 +1527,12 @@ export class ChunkManager3D {
     // Get chunk coordinates
     const chunkX = Math.floor(floorX / CHUNK_SIZE);
     const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
-    const posKey = `${floorX},${floorY},${floorZ}`;
     
-    // Check if this is a placed block - if so, remove from placedBlocks
-    const placedMap = this.placedBlocks.get(chunkKey);
-    if (placedMap && placedMap.has(posKey)) {
-      placedMap.delete(posKey);
-    } else {
-      // Track this terrain block as broken
-      if (!this.brokenBlocks.has(chunkKey)) {
-        this.brokenBlocks.set(chunkKey, new Set());
-      }
-      this.brokenBlocks.get(chunkKey)!.add(posKey);
-    }
+    // Placed or generated, the block is air from now on
+    this.edits.set(floorX, floorY, floorZ, BlockType.Air);
     
     // Get chunk data
-    const data = this.chunkData.get(chunkKey);
+    const data = this.chunks.get(chunkX, chunkZ)?.data;
     if (data) {
       // Calculate local coordinates
       const lx = ((floorX % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
@@ -1450,24 +1572,9 @@ export class ChunkManager3D {
       return false; // Position already occupied
     }
     
-    // Get chunk coordinates
-    const chunkX = Math.floor(floorX / CHUNK_SIZE);
-    const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
-    
-    // Initialize placed blocks map for this chunk if needed
-    if (!this.placedBlocks.has(chunkKey)) {
-      this.placedBlocks.set(chunkKey, new Map());
-    }
-    
-    // Add block to placed blocks
-    const posKey = `${floorX},${floorY},${floorZ}`;
-    this.placedBlocks.get(chunkKey)!.set(posKey, blockType);
-    
-    // If this position was previously marked as broken, remove that mark
-    const brokenSet = this.brokenBlocks.get(chunkKey);
-    if (brokenSet) {
-      brokenSet.delete(posKey);
+    // Record the placed block (replaces a broken mark); fails above the world height
+    if (!this.edits.set(floorX, floorY, floorZ, blockType)) {
+      return false;
     }
     
     // Note: We don't rebuild the chunk here - the falling block manager will handle that
@@ -1508,27 +1615,14 @@ export class ChunkManager3D {
       }
     }
     
-    // Get chunk coordinates
-    const chunkX = Math.floor(floorX / CHUNK_SIZE);
-    const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
-    
-    // Initialize placed blocks map for this chunk if needed
-    if (!this.placedBlocks.has(chunkKey)) {
-      this.placedBlocks.set(chunkKey, new Map());
-    }
-    
-    // Add block to placed blocks
-    const posKey = `${floorX},${floorY},${floorZ}`;
-    this.placedBlocks.get(chunkKey)!.set(posKey, blockType);
-    
-    // If this position was previously marked as broken, remove that mark
-    const brokenSet = this.brokenBlocks.get(chunkKey);
-    if (brokenSet) {
-      brokenSet.delete(posKey);
+    // Record the placed block (replaces a broken mark); fails above the world height
+    if (!this.edits.set(floorX, floorY, floorZ, blockType)) {
+      return false;
     }
     
     // Rebuild chunk mesh
+    const chunkX = Math.floor(floorX / CHUNK_SIZE);
+    const chunkZ = Math.floor(floorZ / CHUNK_SIZE);
     this.rebuildChunk(chunkX, chunkZ);
     
     return true;
@@ -1538,15 +1632,8 @@ export class ChunkManager3D {
    * Get placed block at position (if any)
    */
   getPlacedBlock(x: number, y: number, z: number): BlockType | null {
-    const chunkX = Math.floor(x / CHUNK_SIZE);
-    const chunkZ = Math.floor(z / CHUNK_SIZE);
-    const chunkKey = `${chunkX},${chunkZ}`;
-    
-    const placedMap = this.placedBlocks.get(chunkKey);
-    if (!placedMap) return null;
-    
-    const posKey = `${Math.floor(x)},${Math.floor(y)},${Math.floor(z)}`;
-    return placedMap.get(posKey) || null;
+    const edit = this.edits.get(Math.floor(x), Math.floor(y), Math.floor(z));
+    return edit === VOXEL_NONE || edit === BlockType.Air ? null : edit;
   }
 
   /**
@@ -1714,7 +1801,6 @@ export class ChunkManager3D {
   getBlockTypeAt(x: number, y: number, z: number): BlockType | null {
     const chunkX = Math.floor(x / CHUNK_SIZE);
     const chunkZ = Math.floor(z / CHUNK_SIZE);
-    const key = `${chunkX},${chunkZ}`;
     
     // First check if there's a placed block at this position
     const placedBlock = this.getPlacedBlock(x, y, z);
@@ -1727,8 +1813,9 @@ export class ChunkManager3D {
       return null;
     }
     
-    const data = this.chunkData.get(key);
-    if (!data) return null;
+    const chunk = this.chunks.get(chunkX, chunkZ);
+    if (!chunk) return null;
+    const data = chunk.data;
     
     const lx = ((Math.floor(x) % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
     const lz = ((Math.floor(z) % CHUNK_SIZE) + CHUNK_SIZE) % CHUNK_SIZE;
@@ -1758,31 +1845,21 @@ export class ChunkManager3D {
     }
     
     // Check for tree blocks at this position
-    if (data.trees) {
-      for (const tree of data.trees) {
-        if (tree.blocks) {
-          const treeBaseX = chunkX * CHUNK_SIZE + tree.x;
-          const treeBaseZ = chunkZ * CHUNK_SIZE + tree.z;
-          // Trees sit ON TOP of ground block, so +1
-          const treeBaseY = data.heightMap[tree.z * CHUNK_SIZE + tree.x] + 1;
-          
-          for (const block of tree.blocks) {
-            const blockX = treeBaseX + block.dx;
-            const blockY = treeBaseY + block.dy;
-            const blockZ = treeBaseZ + block.dz;
-            
-            if (Math.floor(x) === blockX && Math.floor(y) === blockY && Math.floor(z) === blockZ) {
-              // Return appropriate block type
-              if (block.type === 'log') return TreeTypeToLogBlockType[tree.type];
-              if (block.type === 'leaves') return TreeTypeToLeavesBlockType[tree.type];
-              if (block.type === 'cactus') return BlockType.Cactus;
-            }
-          }
-        }
-      }
-    }
+    return this.getTreeBlockAt(chunk, lx, floorY, lz);
+  }
+  
+  /**
+   * Generated tree block at a chunk-local position (ignores edits)
+   */
+  private getTreeBlockAt(chunk: LoadedChunk, lx: number, y: number, lz: number): BlockType | null {
+    const index = chunk.trees;
+    if (!index) return null;
     
-    return null;
+    const level = y - index.minY;
+    if (level < 0 || level >= index.levels) return null;
+    
+    const block = index.blocks[(level * CHUNK_SIZE + lz) * CHUNK_SIZE + lx];
+    return block !== 0 ? block : null;
   }
 
   /**
@@ -1945,12 +2022,16 @@ export class ChunkManager3D {
    * Clean up
    */
   destroy(): void {
-    for (const [key, group] of this.chunks) {
-      this.unloadChunk(key, group);
-    }
+    this.chunks.forEach((chunk, cx, cz) => this.unloadChunk(cx, cz, chunk));
+    
+    this.chunkWorker?.terminate();
+    this.chunkWorker = null;
+    this.pendingChunks.clear();
     
     // Clean up falling block manager
     this.fallingBlockManager.destroy();
+    
+    this.edits.destroy();
   }
 }
 
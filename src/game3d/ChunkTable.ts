@@ -0,0 +1,140 @@
+/**
+ * Chunk Table - per-chunk values keyed by chunk coordinates
+ * Open-addressed (linear probing) on a packed integer key, so lookups
+ * allocate nothing. Entries may be deleted, but not added, during forEach.
+ */
+
+const INITIAL_CAPACITY = 64;   // Slots, a power of two; kept at most half used
+
+// Slot states
+const EMPTY = 0;
+const FULL = 1;
+const DELETED = 2;   // Tombstone: keeps probe chains intact until the next rehash
+
+/**
+ * Pack chunk coordinates into one safe integer (chunkX in the high bits)
+ * Exact for |chunkX| < 2^20, far beyond the world border.
+ */
+export function packChunkKey(chunkX: number, chunkZ: number): number {
+  return chunkX * 0x100000000 + (chunkZ >>> 0);
+}
+
+function hashChunk(chunkX: number, chunkZ: number): number {
+  const hash = Math.imul(chunkX, 0x9E3779B1) ^ Math.imul(chunkZ, 0x85EBCA77);
+  return hash ^ (hash >>> 16);
+}
+
+export class ChunkTable<T> {
+  private keys: Float64Array = new Float64Array(0);
+  private states: Uint8Array = new Uint8Array(0);
+  private values: (T | undefined)[] = [];
+  private mask = 0;
+  private count = 0;
+  private used = 0;   // FULL and DELETED slots
+
+  constructor() {
+    this.allocate(INITIAL_CAPACITY);
+  }
+
+  /**
+   * Number of entries
+   */
+  get size(): number {
+    return this.count;
+  }
+
+  get(chunkX: number, chunkZ: number): T | undefined {
+    const slot = this.find(chunkX, chunkZ);
+    return slot >= 0 ? this.values[slot] : undefined;
+  }
+
+  has(chunkX: number, chunkZ: number): boolean {
+    return this.find(chunkX, chunkZ) >= 0;
+  }
+
+  set(chunkX: number, chunkZ: number, value: T): void {
+    const existing = this.find(chunkX, chunkZ);
+    if (existing >= 0) {
+      this.values[existing] = value;
+      return;
+    }
+
+    if ((this.used + 1) * 2 > this.states.length) {
+      // Grow when live entries fill a quarter; otherwise just drop tombstones
+      const capacity = this.states.length;
+      this.rehash((this.count + 1) * 4 > capacity ? capacity * 2 : capacity);
+    }
+
+    let slot = hashChunk(chunkX, chunkZ) & this.mask;
+    while (this.states[slot] === FULL) slot = (slot + 1) & this.mask;
+    if (this.states[slot] === EMPTY) this.used++;
+
+    this.keys[slot] = packChunkKey(chunkX, chunkZ);
+    this.states[slot] = FULL;
+    this.values[slot] = value;
+    this.count++;
+  }
+
+  delete(chunkX: number, chunkZ: number): boolean {
+    const slot = this.find(chunkX, chunkZ);
+    if (slot < 0) return false;
+
+    this.states[slot] = DELETED;
+    this.values[slot] = undefined;
+    this.count--;
+    return true;
+  }
+
+  clear(): void {
+    this.allocate(INITIAL_CAPACITY);
+  }
+
+  /**
+   * Visit every entry (in no particular order)
+   */
+  forEach(callback: (value: T, chunkX: number, chunkZ: number) => void): void {
+    const states = this.states;
+    for (let slot = 0; slot < states.length; slot++) {
+      if (states[slot] !== FULL) continue;
+      const key = this.keys[slot];
+      // High 32 bits are chunkX; ToInt32 of the key leaves chunkZ
+      callback(this.values[slot] as T, Math.floor(key / 0x100000000), key | 0);
+    }
+  }
+
+  /**
+   * Slot holding (chunkX, chunkZ), or -1
+   */
+  private find(chunkX: number, chunkZ: number): number {
+    const key = packChunkKey(chunkX, chunkZ);
+    const states = this.states;
+    let slot = hashChunk(chunkX, chunkZ) & this.mask;
+    while (states[slot] !== EMPTY) {
+      if (states[slot] === FULL && this.keys[slot] === key) return slot;
+      slot = (slot + 1) & this.mask;
+    }
+    return -1;
+  }
+
+  private allocate(capacity: number): void {
+    this.keys = new Float64Array(capacity);
+    this.states = new Uint8Array(capacity);
+    this.values = new Array<T | undefined>(capacity);
+    this.mask = capacity - 1;
+    this.count = 0;
+    this.used = 0;
+  }
+
+  private rehash(capacity: number): void {
+    const keys = this.keys;
+    const states = this.states;
+    const values = this.values;
+    this.allocate(capacity);
+
+    for (let slot = 0; slot < states.length; slot++) {
+      if (states[slot] !== FULL) continue;
+      const key = keys[slot];
+      this.set(Math.floor(key / 0x100000000), key | 0, values[slot] as T);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * Chunk Worker Client - main-thread side of the chunk generation worker
+ * Requests are fire-and-forget; finished chunks are buffered until polled.
+ */
+
+import type { GeneratedChunk } from '../world/ChunkGenerator';
+import type { ChunkWorkerRequest, ChunkWorkerResponse } from '../world/ChunkWorker';
+
+export class ChunkWorkerClient {
+  private worker: Worker;
+  private ready = false;
+  private failed = false;
+  private completed: GeneratedChunk[] = [];
+
+  constructor(seed: number) {
+    this.worker = new Worker(new URL('../world/ChunkWorker.ts', import.meta.url), { type: 'module' });
+    
+    this.worker.onmessage = (event: MessageEvent<ChunkWorkerResponse>) => {
+      const msg = event.data;
+      switch (msg.type) {
+        case 'ready':
+          this.ready = true;
+          break;
+        case 'error':
+          console.warn(`Chunk worker failed to start, generating on the main thread: ${msg.message}`);
+          this.fail();
+          break;
+        case 'chunk':
+          this.completed.push({ chunkX: msg.chunkX, chunkZ: msg.chunkZ, data: msg.data });
+          break;
+      }
+    };
+    this.worker.onerror = (event) => {
+      console.warn('Chunk worker error, generating on the main thread:', event.message);
+      this.fail();
+    };
+    
+    this.send({ type: 'init', seed });
+  }
+
+  /**
+   * Check if workers are supported in this environment
+   */
+  static isSupported(): boolean {
+    return typeof Worker !== 'undefined';
+  }
+
+  /**
+   * Whether the worker is up and accepting requests
+   */
+  isReady(): boolean {
+    return this.ready && !this.failed;
+  }
+
+  /**
+   * Whether the worker died; requests still in flight will never arrive
+   */
+  hasFailed(): boolean {
+    return this.failed;
+  }
+
+  /**
+   * Request a chunk
+   * @return false if the worker isn't ready (caller should generate it itself)
+   */
+  request(chunkX: number, chunkZ: number): boolean {
+    if (!this.isReady()) return false;
+    this.send({ type: 'generate', chunkX, chunkZ });
+    return true;
+  }
+
+  /**
+   * Cancel a requested chunk if the worker hasn't started it yet
+   * A chunk that is already being generated still arrives and should be ignored.
+   */
+  cancel(chunkX: number, chunkZ: number): void {
+    if (!this.isReady()) return;
+    this.send({ type: 'cancel', chunkX, chunkZ });
+  }
+
+  /**
+   * Take up to max finished chunks
+   */
+  poll(max: number): GeneratedChunk[] {
+    return this.completed.splice(0, max);
+  }
+
+  /**
+   * Stop the worker
+   */
+  terminate(): void {
+    this.worker.terminate();
+    this.ready = false;
+    this.completed.length = 0;
+  }
+
+  private fail(): void {
+    this.failed = true;
+    this.worker.terminate();
+  }
+
+  private send(message: ChunkWorkerRequest): void {
+    this.worker.postMessage(message);
+  }
+}
@@ -32,6 +32,7 @@ interface DebugInfo {
   drawCalls: number;
   blockBelow: string | null;
   targetedBlock: string | null;
+  wasmVariant: string;
 }
 
 export class DebugUI3D {
@@ -68,6 +69,10 @@ export class DebugUI3D {
           <span class="debug-label">🎨 Draw Calls:</span>
           <span class="debug-value" id="debug-drawcalls">--</span>
         </div>
+        <div class="debug-row">
+          <span class="debug-label">⚙️ WASM:</span>
+          <span class="debug-value" id="debug-wasm">--</span>
+        </div>
         <hr class="debug-divider">
         <div class="debug-row">
           <span class="debug-label">📍 Position:</span>
@@ -242,6 +247,7 @@ export class DebugUI3D {
     setVal('debug-state', info.playerState);
     setVal('debug-triangles', this.formatNumber(info.triangles));
     setVal('debug-drawcalls', String(info.drawCalls));
+    setVal('debug-wasm', info.wasmVariant);
     setVal('debug-block-below', info.blockBelow || 'Air');
     setVal('debug-target', info.targetedBlock || 'None');
     
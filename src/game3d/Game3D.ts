@@ -15,6 +15,7 @@ import { DroppedItemManager } from './DroppedItemManager';
 import { BlockBreaking } from './BlockBreaking';
 import { Crosshair } from './Crosshair';
 import { createChunkGenerator, type ChunkGenerator } from '../world/ChunkGenerator';
+import { getCubiomesVariant } from '../cubiomes/wasm-bindings';
 import { BlockType, LeavesToSaplingBlockType, SAPLING_DROP_CHANCE } from '../world/types';
 import { getSoundManager } from './SoundManager';
 import { getMusicManager } from './MusicManager';
@@ -471,24 +472,12 @@ export class Game3D {
   private findSpawnPoint(): { x: number; y: number; z: number } {
     if (!this.generator) return { x: 0, y: 64, z: 0 };
     
-    // Search for land
-    for (let radius = 0; radius < 1000; radius += 8) {
-      for (let i = 0; i < 16; i++) {
-        const angle = (i / 16) * Math.PI * 2;
-        const x = Math.floor(Math.cos(angle) * radius);
-        const z = Math.floor(Math.sin(angle) * radius);
-        
-        const height = this.generator.getHeightAt(x, z);
-        const biome = this.generator.getBiomeAt(x, z);
-        
-        // Skip ocean biomes
-        if (this.generator.isOcean(biome)) continue;
-        
-        if (height >= 63 && height <= 80) {
-          console.log(`🏠 Spawn found at (${x}, ${height}, ${z})`);
-          return { x, y: height + 1, z };
-        }
-      }
+    // Native coarse-to-fine search for land
+    const spot = this.generator.findSpawn(1000);
+    if (spot) {
+      const height = this.generator.getHeightAt(spot.x, spot.z);
+      console.log(`🏠 Spawn found at (${spot.x}, ${height}, ${spot.z})`);
+      return { x: spot.x, y: height + 1, z: spot.z };
     }
     
     return { x: 0, y: 64, z: 0 };
@@ -1480,6 +1469,7 @@ export class Game3D {
       drawCalls: renderInfo.calls,
       blockBelow,
       targetedBlock,
+      wasmVariant: getCubiomesVariant() ?? '--',
     });
   }
 
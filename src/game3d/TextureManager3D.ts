@@ -134,6 +134,81 @@ const FALLBACK_COLORS: Partial<Record<BlockType, number>> = {
   [BlockType.Air]: 0x000000,
 };
 
+// Biome IDs from cubiomes
+const TINT_BIOMES = {
+  swamp: 6,
+  mangrove_swamp: 51,
+  jungle: 21,
+  bamboo_jungle: 48,
+  sparse_jungle: 23,
+  badlands: 37,
+  wooded_badlands: 38,
+  wooded_badlands_plateau: 39,
+  eroded_badlands: 165,
+  dark_forest: 29,
+  snowy_plains: 12,
+  snowy_taiga: 30,
+  snowy_slopes: 184,
+  snowy_beach: 26,
+  ice_spikes: 140,
+  frozen_peaks: 182,
+  grove: 185,
+  snowy_mountains: 13,
+  cherry_grove: 186,
+  savanna: 35,
+  savanna_plateau: 36,
+  windswept_savanna: 163,
+  desert: 2,
+  birch_forest: 27,
+  old_growth_birch_forest: 155,
+  taiga: 5,
+  old_growth_pine_taiga: 32,
+  old_growth_spruce_taiga: 160,
+};
+
+// RGB tint colors from Minecraft colormap
+const BIOME_TINTS: Record<number, [number, number, number]> = {
+  // Swamp - murky green
+  [TINT_BIOMES.swamp]: [106, 112, 57],
+  [TINT_BIOMES.mangrove_swamp]: [141, 154, 50],
+  // Jungle - lush vibrant green
+  [TINT_BIOMES.jungle]: [89, 201, 60],
+  [TINT_BIOMES.bamboo_jungle]: [89, 201, 60],
+  [TINT_BIOMES.sparse_jungle]: [89, 201, 60],
+  // Badlands - dead dry grass
+  [TINT_BIOMES.badlands]: [144, 129, 77],
+  [TINT_BIOMES.wooded_badlands]: [144, 129, 77],
+  [TINT_BIOMES.wooded_badlands_plateau]: [144, 129, 77],
+  [TINT_BIOMES.eroded_badlands]: [144, 129, 77],
+  // Dark forest - darker green
+  [TINT_BIOMES.dark_forest]: [80, 122, 50],
+  // Snowy biomes - cold blue-green
+  [TINT_BIOMES.snowy_plains]: [128, 180, 151],
+  [TINT_BIOMES.snowy_taiga]: [128, 180, 151],
+  [TINT_BIOMES.snowy_slopes]: [128, 180, 151],
+  [TINT_BIOMES.snowy_beach]: [128, 180, 151],
+  [TINT_BIOMES.ice_spikes]: [128, 180, 151],
+  [TINT_BIOMES.frozen_peaks]: [128, 180, 151],
+  [TINT_BIOMES.grove]: [128, 180, 151],
+  [TINT_BIOMES.snowy_mountains]: [128, 180, 151],
+  // Cherry grove - bright green
+  [TINT_BIOMES.cherry_grove]: [182, 219, 97],
+  // Savanna - dry yellow grass
+  [TINT_BIOMES.savanna]: [191, 183, 85],
+  [TINT_BIOMES.savanna_plateau]: [191, 183, 85],
+  [TINT_BIOMES.windswept_savanna]: [191, 183, 85],
+  // Desert - same dry color
+  [TINT_BIOMES.desert]: [191, 183, 85],
+  // Birch forest
+  [TINT_BIOMES.birch_forest]: [136, 183, 97],
+  [TINT_BIOMES.old_growth_birch_forest]: [136, 183, 97],
+  // Taiga
+  [TINT_BIOMES.taiga]: [134, 175, 97],
+  [TINT_BIOMES.old_growth_pine_taiga]: [134, 175, 97],
+  [TINT_BIOMES.old_growth_spruce_taiga]: [134, 175, 97],
+};
+const DEFAULT_BIOME_TINT: [number, number, number] = [145, 189, 89]; // Plains green
+
 export class TextureManager3D {
   private loader: THREE.TextureLoader;
   private textures: Map<BlockType, THREE.Texture> = new Map();
@@ -605,81 +680,7 @@ export class TextureManager3D {
    * Get biome tint color for grass/leaves (from Minecraft colormap)
    */
   getBiomeTint(biome: number): THREE.Color {
-    // Biome IDs from cubiomes
-    const BiomeID = {
-      swamp: 6,
-      mangrove_swamp: 51,
-      jungle: 21,
-      bamboo_jungle: 48,
-      sparse_jungle: 23,
-      badlands: 37,
-      wooded_badlands: 38,
-      wooded_badlands_plateau: 39,
-      eroded_badlands: 165,
-      dark_forest: 29,
-      snowy_plains: 12,
-      snowy_taiga: 30,
-      snowy_slopes: 184,
-      snowy_beach: 26,
-      ice_spikes: 140,
-      frozen_peaks: 182,
-      grove: 185,
-      snowy_mountains: 13,
-      cherry_grove: 186,
-      savanna: 35,
-      savanna_plateau: 36,
-      windswept_savanna: 163,
-      desert: 2,
-      birch_forest: 27,
-      old_growth_birch_forest: 155,
-      taiga: 5,
-      old_growth_pine_taiga: 32,
-      old_growth_spruce_taiga: 160,
-    };
-
-    // RGB tint colors from Minecraft colormap
-    const tintMap: Record<number, [number, number, number]> = {
-      // Swamp - murky green
-      [BiomeID.swamp]: [106, 112, 57],
-      [BiomeID.mangrove_swamp]: [141, 154, 50],
-      // Jungle - lush vibrant green
-      [BiomeID.jungle]: [89, 201, 60],
-      [BiomeID.bamboo_jungle]: [89, 201, 60],
-      [BiomeID.sparse_jungle]: [89, 201, 60],
-      // Badlands - dead dry grass
-      [BiomeID.badlands]: [144, 129, 77],
-      [BiomeID.wooded_badlands]: [144, 129, 77],
-      [BiomeID.wooded_badlands_plateau]: [144, 129, 77],
-      [BiomeID.eroded_badlands]: [144, 129, 77],
-      // Dark forest - darker green
-      [BiomeID.dark_forest]: [80, 122, 50],
-      // Snowy biomes - cold blue-green
-      [BiomeID.snowy_plains]: [128, 180, 151],
-      [BiomeID.snowy_taiga]: [128, 180, 151],
-      [BiomeID.snowy_slopes]: [128, 180, 151],
-      [BiomeID.snowy_beach]: [128, 180, 151],
-      [BiomeID.ice_spikes]: [128, 180, 151],
-      [BiomeID.frozen_peaks]: [128, 180, 151],
-      [BiomeID.grove]: [128, 180, 151],
-      [BiomeID.snowy_mountains]: [128, 180, 151],
-      // Cherry grove - bright green
-      [BiomeID.cherry_grove]: [182, 219, 97],
-      // Savanna - dry yellow grass
-      [BiomeID.savanna]: [191, 183, 85],
-      [BiomeID.savanna_plateau]: [191, 183, 85],
-      [BiomeID.windswept_savanna]: [191, 183, 85],
-      // Desert - same dry color
-      [BiomeID.desert]: [191, 183, 85],
-      // Birch forest
-      [BiomeID.birch_forest]: [136, 183, 97],
-      [BiomeID.old_growth_birch_forest]: [136, 183, 97],
-      // Taiga
-      [BiomeID.taiga]: [134, 175, 97],
-      [BiomeID.old_growth_pine_taiga]: [134, 175, 97],
-      [BiomeID.old_growth_spruce_taiga]: [134, 175, 97],
-    };
-
-    const rgb = tintMap[biome] || [145, 189, 89]; // Default plains green
+    const rgb = BIOME_TINTS[biome] || DEFAULT_BIOME_TINT;
     return new THREE.Color(rgb[0] / 255, rgb[1] / 255, rgb[2] / 255);
   }
 
@@ -2,14 +2,9 @@
  * Chunk Generator - Generates Minecraft-style blocky terrain using cubiomes WASM
  */
 
-import { WasmGenerator, createWasmGenerator } from '../cubiomes/wasm-bindings';
+import { WasmGenerator, createWasmGenerator, SURFACE_SWAMP, type ChunkSurface } from '../cubiomes/wasm-bindings';
 import { SeededRandom, PerlinNoise } from '../cubiomes/noise';
-import { 
-  generateTree, 
-  getTreeTypeForBiome, 
-  getTreeDensity,
-  type TreeBlock
-} from './vegetation/TreeGenerator';
+import { buildTreeTable } from './vegetation/TreeGenerator';
 
 // Re-export shared types for backward compatibility
 export { 
@@ -27,7 +22,6 @@ export {
 
 // Import for local use
 import { 
-  CHUNK_SIZE, 
   SEA_LEVEL, 
   BiomeID, 
   TreeType, 
@@ -35,6 +29,25 @@ import {
   type BiomeIDType 
 } from './types';
 
+// Biome IDs that are always open water / frozen water at the surface
+// (numeric IDs included in case the enum is wrong)
+const OCEAN_BIOMES: readonly number[] = [
+  BiomeID.ocean,
+  BiomeID.deep_ocean,
+  BiomeID.cold_ocean,
+  BiomeID.deep_cold_ocean,
+  BiomeID.lukewarm_ocean,
+  BiomeID.deep_lukewarm_ocean,
+  BiomeID.warm_ocean,
+  0, 24, 44, 45, 46, 47, 48, 49, 50
+];
+
+const FROZEN_OCEAN_BIOMES: readonly number[] = [
+  BiomeID.frozen_ocean,
+  BiomeID.deep_frozen_ocean,
+  10, 50
+];
+
 export interface BlockData {
   type: BlockType;
   biome: BiomeIDType;
@@ -91,16 +104,23 @@ export interface TreeData {
   x: number;
   z: number;
   type: TreeType;
-  height: number;
-  blocks: TreeBlock[];  // Full block data for rendering
+  variant: number;  // Shape, see getTreeTemplate
 }
 
 // Re-export from vegetation module
-export { type TreeBlock, type GeneratedTree } from './vegetation/TreeGenerator';
+export {
+  TreeBlockKind,
+  getTreeTemplate,
+  getTreeTemplateHeight,
+  treeBlockDx,
+  treeBlockDy,
+  treeBlockDz,
+  treeBlockKind,
+} from './vegetation/TreeGenerator';
 
 export interface ChunkData {
   heightMap: Uint8Array;
-  biomeMap: Int16Array;
+  biomeMap: Uint8Array;
   topBlock: Uint8Array;
   trees: TreeData[];
   waterDepth: Uint8Array;
@@ -109,6 +129,15 @@ export interface ChunkData {
   frontNeighborHeights: Uint8Array; // at z = CHUNK_SIZE
 }
 
+/**
+ * A chunk produced by region generation
+ */
+export interface GeneratedChunk {
+  chunkX: number;
+  chunkZ: number;
+  data: ChunkData;
+}
+
 /**
  * Chunk Generator using real cubiomes WASM module
  */
@@ -118,18 +147,19 @@ export class ChunkGenerator {
   private initialized = false;
   private initPromise: Promise<void> | null = null;
   
-  // Noise generators for smooth terrain
+  // Native worker threads for background generation (threaded WASM build only)
+  private backgroundWorkers = 0;
+  
+  // Noise generator for smooth terrain
+  // (the swamp detail noise lives in the native surface pass)
   private terrainNoise: PerlinNoise | null = null;
-  private detailNoise: PerlinNoise | null = null;
 
   constructor(seed: number) {
     this.seed = seed;
     
     // Initialize noise generators
     const rng1 = new SeededRandom(seed);
-    const rng2 = new SeededRandom(seed ^ 0x12345678);
     this.terrainNoise = new PerlinNoise(rng1);
-    this.detailNoise = new PerlinNoise(rng2);
   }
 
   /**
@@ -141,6 +171,13 @@ export class ChunkGenerator {
 
     this.initPromise = (async () => {
       this.generator = await createWasmGenerator(BigInt(this.seed));
+      this.generator.configureSurface(this.seed, this.buildSurfaceTable());
+      this.generator.configureTrees(buildTreeTable());
+      
+      // Generate off the main thread when the loaded build has threads
+      const cores = typeof navigator !== 'undefined' ? navigator.hardwareConcurrency || 2 : 2;
+      this.backgroundWorkers = this.generator.startWorkers(Math.max(1, Math.min(4, cores - 1)));
+      
       this.initialized = true;
       console.log(`✅ ChunkGenerator initialized with seed: ${this.seed}`);
     })();
@@ -164,118 +201,94 @@ export class ChunkGenerator {
       throw new Error('Generator not initialized. Call init() first.');
     }
 
-    const heightMap = new Uint8Array(CHUNK_SIZE * CHUNK_SIZE);
-    const biomeMap = new Int16Array(CHUNK_SIZE * CHUNK_SIZE);
-    const topBlock = new Uint8Array(CHUNK_SIZE * CHUNK_SIZE);
-    const waterDepth = new Uint8Array(CHUNK_SIZE * CHUNK_SIZE);
-    const rightNeighborHeights = new Uint8Array(CHUNK_SIZE);
-    const frontNeighborHeights = new Uint8Array(CHUNK_SIZE);
-    const trees: TreeData[] = [];
+    // Biomes, heights, smoothing and top blocks in a single native call
+    const surface = this.generator.genChunkSurface(chunkX, chunkZ);
+    return this.buildChunk(chunkX, chunkZ, surface);
+  }
 
-    const worldX = chunkX * CHUNK_SIZE;
-    const worldZ = chunkZ * CHUNK_SIZE;
-    
-    // Generate biomes for entire chunk at once (plus buffer for neighbors if needed, but we'll query point-wise for edges)
-    const biomes = this.generator.genBiomes2D(1, worldX, worldZ, CHUNK_SIZE, CHUNK_SIZE, 63);
-
-    // First pass: Calculate raw heights
-    for (let lz = 0; lz < CHUNK_SIZE; lz++) {
-      for (let lx = 0; lx < CHUNK_SIZE; lx++) {
-        const idx = lz * CHUNK_SIZE + lx;
-        const wx = worldX + lx;
-        const wz = worldZ + lz;
-
-        const biome = biomes[idx];
-        biomeMap[idx] = biome;
-
-        // Calculate smooth terrain height
-        const height = this.calculateSmoothHeight(wx, wz, biome);
-        heightMap[idx] = height;
-      }
-    }
-    
-    // Calculate border heights for seamless connections
-    // Right border (x = CHUNK_SIZE)
-    for (let lz = 0; lz < CHUNK_SIZE; lz++) {
-      const wx = worldX + CHUNK_SIZE; // The column just outside to the right
-      const wz = worldZ + lz;
-      const biome = this.getBiomeAt(wx, wz);
-      rightNeighborHeights[lz] = this.calculateSmoothHeight(wx, wz, biome);
-    }
-    
-    // Front border (z = CHUNK_SIZE)
-    for (let lx = 0; lx < CHUNK_SIZE; lx++) {
-      const wx = worldX + lx;
-      const wz = worldZ + CHUNK_SIZE; // The row just outside to the front
-      const biome = this.getBiomeAt(wx, wz);
-      frontNeighborHeights[lx] = this.calculateSmoothHeight(wx, wz, biome);
-    }
-    
-    // Height smoothing pass: ensure max 1-block difference between neighbors
-    // Multiple passes for better smoothing
-    for (let pass = 0; pass < 3; pass++) {
-      for (let lz = 0; lz < CHUNK_SIZE; lz++) {
-        for (let lx = 0; lx < CHUNK_SIZE; lx++) {
-          const idx = lz * CHUNK_SIZE + lx;
-          const h = heightMap[idx];
-          
-          // Check neighbors (handling edges by using calculated border heights)
-          const nNorth = (lz > 0) ? heightMap[(lz - 1) * CHUNK_SIZE + lx] : h; // Assume flat if no context (or could fetch)
-          const nSouth = (lz < CHUNK_SIZE - 1) ? heightMap[(lz + 1) * CHUNK_SIZE + lx] : frontNeighborHeights[lx];
-          const nWest = (lx > 0) ? heightMap[lz * CHUNK_SIZE + (lx - 1)] : h;
-          const nEast = (lx < CHUNK_SIZE - 1) ? heightMap[lz * CHUNK_SIZE + (lx + 1)] : rightNeighborHeights[lz];
-          
-          const neighbors = [nNorth, nSouth, nWest, nEast];
-          
-          // Clamp height to be within 1 of all neighbors
-          let minN = Math.min(...neighbors);
-          let maxN = Math.max(...neighbors);
-          heightMap[idx] = Math.max(minN - 1, Math.min(maxN + 1, h));
-        }
-      }
+  /**
+   * Generate a rectangular region of chunks from one native surface pass
+   * cubiomes shares noise work across adjacent cells, so one large Range is
+   * much cheaper than a Range per chunk. Chunks rejected by the optional
+   * filter (e.g. already loaded) are skipped but still covered by the pass.
+   */
+  generateRegion(
+    minChunkX: number,
+    minChunkZ: number,
+    countX: number,
+    countZ: number,
+    filter?: (chunkX: number, chunkZ: number) => boolean
+  ): GeneratedChunk[] {
+    if (!this.generator) {
+      throw new Error('Generator not initialized. Call init() first.');
     }
 
-    // Second pass: Determine blocks and water
-    for (let lz = 0; lz < CHUNK_SIZE; lz++) {
-      for (let lx = 0; lx < CHUNK_SIZE; lx++) {
-        const idx = lz * CHUNK_SIZE + lx;
-        const biome = biomeMap[idx];
-        const height = heightMap[idx];
-        const wx = worldX + lx;
-        const wz = worldZ + lz;
-
-        const { block, waterLevel } = this.getTopBlock(biome, height, wx, wz);
-        topBlock[idx] = block;
-        waterDepth[idx] = waterLevel > 0 ? SEA_LEVEL - height : 0;
+    const surfaces = this.generator.genRegionSurfaces(minChunkX, minChunkZ, countX, countZ);
+    const result: GeneratedChunk[] = [];
+
+    for (let j = 0; j < countZ; j++) {
+      for (let i = 0; i < countX; i++) {
+        const chunkX = minChunkX + i;
+        const chunkZ = minChunkZ + j;
+        if (filter && !filter(chunkX, chunkZ)) continue;
+
+        result.push({ chunkX, chunkZ, data: this.buildChunk(chunkX, chunkZ, surfaces[j * countX + i]) });
       }
     }
 
-    // Generate trees (sparse) - pass topBlock to check for water
-    this.generateTrees(chunkX, chunkZ, heightMap, biomeMap, topBlock, trees);
+    return result;
+  }
 
-    return { heightMap, biomeMap, topBlock, trees, waterDepth, rightNeighborHeights, frontNeighborHeights };
+  /**
+   * Whether chunks can be generated in the background (requestChunk/pollGeneratedChunks)
+   */
+  hasBackgroundGeneration(): boolean {
+    return this.backgroundWorkers > 0;
   }
-  
+
   /**
-   * Calculate terrain height - flat with minimal biome-based steps
-   * All blocks at SEA_LEVEL so water surface (8/9 height) aligns with adjacent land
+   * Queue a chunk for background generation
+   * @return false if it could not be queued (no workers, or queue full)
    */
-  private calculateSmoothHeight(_wx: number, _wz: number, _biome: number): number {
-    // Everything at sea level - water blocks are 8/9 height so their surface
-    // will be at SEA_LEVEL + 8/9 ≈ 63.889, just below land top at 64
-    return SEA_LEVEL;
+  requestChunk(chunkX: number, chunkZ: number): boolean {
+    return this.backgroundWorkers > 0 && this.generator !== null && this.generator.submitChunk(chunkX, chunkZ);
   }
-  
+
   /**
-   * Check if a swamp position should be water using noise
+   * Collect chunks finished in the background (never blocks)
+   * Surfaces come from the workers; trees are added here on the calling thread.
+   * @param max - Maximum number of chunks to return
    */
-  private isSwampWaterPatch(wx: number, wz: number): boolean {
-    if (!this.detailNoise) return false;
-    // Use low-frequency noise for smooth, large water patches
-    const scale = 0.08; // Larger scale = bigger patches
-    const noise = this.detailNoise.sample2D(wx * scale, wz * scale);
-    // ~35% water coverage with smooth transitions
-    return noise < -0.3;
+  pollGeneratedChunks(max: number): GeneratedChunk[] {
+    const result: GeneratedChunk[] = [];
+    if (!this.generator) return result;
+
+    while (result.length < max) {
+      const completed = this.generator.pollCompleted();
+      if (!completed) break;
+
+      const { chunkX, chunkZ, surface } = completed;
+      // A failed background job is retried synchronously
+      const data = surface ? this.buildChunk(chunkX, chunkZ, surface) : this.generateChunk(chunkX, chunkZ);
+      result.push({ chunkX, chunkZ, data });
+    }
+
+    return result;
+  }
+
+  /**
+   * Build chunk data from a native chunk surface
+   * Heights, smoothing, seam heights and top blocks come from the surface
+   * pass in cubiomes_wrapper.c (terrain is flat at SEA_LEVEL, so water
+   * surfaces at 8/9 height sit just below adjacent land). Trees are placed
+   * natively too (wasm/tree_gen.c), on the ACTUAL topBlock values, so none
+   * grow in water; each one references a shared shape template.
+   */
+  private buildChunk(chunkX: number, chunkZ: number, surface: ChunkSurface): ChunkData {
+    const { heightMap, biomeMap, topBlock, waterDepth, rightNeighborHeights, frontNeighborHeights } = surface;
+    const trees = this.generator!.genChunkTrees(chunkX, chunkZ, surface);
+
+    return { heightMap, biomeMap, topBlock, trees, waterDepth, rightNeighborHeights, frontNeighborHeights };
   }
 
   /**
@@ -329,108 +342,99 @@ export class ChunkGenerator {
   }
 
   /**
-   * Get the top block type for a position based on biome
-   * With flat terrain, we use biome to determine block type directly
+   * Build the biome -> top block table consumed by the native surface pass
+   * Evaluated once per biome ID, so per-column classification is a lookup
    */
-  private getTopBlock(biome: number, _height: number, wx: number, wz: number): { block: BlockType; waterLevel: number } {
-    // EXPLICIT ocean check - don't trust isOcean(), check biome IDs directly
-    const OCEAN_BIOMES = [
-      BiomeID.ocean,
-      BiomeID.deep_ocean,
-      BiomeID.cold_ocean,
-      BiomeID.deep_cold_ocean,
-      BiomeID.lukewarm_ocean,
-      BiomeID.deep_lukewarm_ocean,
-      BiomeID.warm_ocean,
-      // Also check numeric IDs in case enum is wrong
-      0, 24, 44, 45, 46, 47, 48, 49, 50
-    ];
-    
-    const FROZEN_OCEAN_BIOMES = [
-      BiomeID.frozen_ocean,
-      BiomeID.deep_frozen_ocean,
-      10, 50 // numeric IDs
-    ];
-    
+  private buildSurfaceTable(): Uint8Array {
+    const table = new Uint8Array(256);
+    for (let biome = 0; biome < table.length; biome++) {
+      table[biome] = this.getSurfaceRule(biome);
+    }
+    return table;
+  }
+
+  /**
+   * Get the top block type for a biome
+   * With flat terrain, we use biome to determine block type directly.
+   * Swamps return SURFACE_SWAMP: the native pass picks water or grass per column.
+   */
+  private getSurfaceRule(biome: number): number {
     // Check frozen ocean first (returns ice)
     if (FROZEN_OCEAN_BIOMES.includes(biome)) {
-      return { block: BlockType.Ice, waterLevel: 0 };
+      return BlockType.Ice;
     }
     
     // Check all ocean biomes
     if (OCEAN_BIOMES.includes(biome)) {
-      return { block: BlockType.Water, waterLevel: 0 };
+      return BlockType.Water;
     }
     
     // Also use isOcean as backup
     if (this.generator?.isOcean(biome)) {
-      return { block: BlockType.Water, waterLevel: 0 };
+      return BlockType.Water;
     }
     
     // River biomes
     if (biome === BiomeID.river || biome === 7) {
-      return { block: BlockType.Water, waterLevel: 0 };
+      return BlockType.Water;
     }
     if (biome === BiomeID.frozen_river || biome === 11) {
-      return { block: BlockType.Ice, waterLevel: 0 };
+      return BlockType.Ice;
     }
 
     // SWAMP special handling - swamps have water mixed with land
-    // Use noise-based detection for water patches (same noise as height calculation)
+    // The native pass uses noise-based detection for water patches
     // Both water and land are at SEA_LEVEL, so water surface is 8/9 block below land top
     if (biome === BiomeID.swamp || biome === BiomeID.mangrove_swamp) {
-      if (this.isSwampWaterPatch(wx, wz)) {
-        return { block: BlockType.Water, waterLevel: 0 };
-      }
-      return { block: BlockType.Grass, waterLevel: 0 };
+      return SURFACE_SWAMP;
     }
     
     // Land biomes - use correct Minecraft block types
     switch (biome) {
       // Desert - sand texture
       case BiomeID.desert:
-        return { block: BlockType.Sand, waterLevel: 0 };
+        return BlockType.Sand;
       
       // Badlands - terracotta texture
       case BiomeID.badlands:
       case BiomeID.eroded_badlands:
-        return { block: BlockType.Terracotta, waterLevel: 0 };
+        return BlockType.Terracotta;
       case BiomeID.wooded_badlands:
       case BiomeID.wooded_badlands_plateau:
-        return { block: BlockType.RedSand, waterLevel: 0 };
+        return BlockType.RedSand;
       
       // Beach - sand texture
       case BiomeID.beach:
       case BiomeID.snowy_beach:
-        return { block: BlockType.Sand, waterLevel: 0 };
+        return BlockType.Sand;
       case BiomeID.stony_shore:
-        return { block: BlockType.Stone, waterLevel: 0 };
+        return BlockType.Stone;
       
       // Snowy biomes - snow texture
       case BiomeID.snowy_plains:
       case BiomeID.snowy_slopes:
       case BiomeID.frozen_peaks:
       case BiomeID.snowy_mountains:
-        return { block: BlockType.Snow, waterLevel: 0 };
+        return BlockType.Snow;
       case BiomeID.ice_spikes:
-        return { block: BlockType.PackedIce, waterLevel: 0 };
+        return BlockType.PackedIce;
       
       // Mountain/stone biomes - stone/gravel texture
       case BiomeID.jagged_peaks:
       case BiomeID.stony_peaks:
-        return { block: BlockType.Stone, waterLevel: 0 };
+        return BlockType.Stone;
       case BiomeID.windswept_hills:
       case BiomeID.windswept_gravelly_hills:
-        return { block: BlockType.Gravel, waterLevel: 0 };
+        return BlockType.Gravel;
       
       // Taiga biomes - podzol texture (brown forest floor)
       case BiomeID.old_growth_pine_taiga:
       case BiomeID.old_growth_spruce_taiga:
-        return { block: BlockType.Podzol, waterLevel: 0 };
+        return BlockType.Podzol;
       
       // Mushroom island - mycelium texture
       case BiomeID.mushroom_fields:
-        return { block: BlockType.Mycelium, waterLevel: 0 };
+        return BlockType.Mycelium;
       
       // ALL grass-based biomes use Grass texture with biome tint:
       // Plains, forests, jungles, swamps, savannas, taigas, etc.
@@ -453,90 +457,10 @@ export class ChunkGenerator {
       case BiomeID.savanna_plateau:
       case BiomeID.windswept_savanna:
       case BiomeID.windswept_forest:
-        return { block: BlockType.Grass, waterLevel: 0 };
+        return BlockType.Grass;
       
       default:
-        return { block: BlockType.Grass, waterLevel: 0 };
-    }
-  }
-
-  /**
-   * Generate trees for a chunk using Pumpkin-style vegetation generation
-   * Based on https://github.com/Pumpkin-MC/Pumpkin
-   */
-  private generateTrees(
-    chunkX: number,
-    chunkZ: number,
-    heightMap: Uint8Array,
-    biomeMap: Int16Array,
-    topBlock: Uint8Array,  // Use the ACTUAL topBlock values (what rendering uses)
-    trees: TreeData[]
-  ): void {
-    // Deterministic RNG for this chunk
-    const rng = new SeededRandom(this.seed ^ (chunkX * 341873128712 + chunkZ * 132897987541));
-    
-    // Get dominant biome for density calculation
-    const centerIdx = (CHUNK_SIZE / 2) * CHUNK_SIZE + (CHUNK_SIZE / 2);
-    const dominantBiome = biomeMap[centerIdx];
-    const targetTreeCount = getTreeDensity(dominantBiome);
-    
-    if (targetTreeCount === 0) return;
-    
-    // Use Poisson-like distribution for natural tree placement
-    // Try multiple positions based on density
-    const attempts = targetTreeCount * 3;
-    let placedCount = 0;
-    
-    for (let attempt = 0; attempt < attempts && placedCount < targetTreeCount; attempt++) {
-      // Random position within chunk (avoiding edges for tree spread)
-      const lx = 2 + rng.nextBounded(CHUNK_SIZE - 4);
-      const lz = 2 + rng.nextBounded(CHUNK_SIZE - 4);
-      
-      const idx = lz * CHUNK_SIZE + lx;
-      const biome = biomeMap[idx];
-      const height = heightMap[idx];
-      const actualBlock = topBlock[idx];  // What the terrain ACTUALLY renders as
-      
-      // Skip water and ice blocks
-      if (actualBlock === BlockType.Water || actualBlock === BlockType.Ice) {
-        continue;
-      }
-      
-      // Skip if below sea level (extra safety)
-      if (height < SEA_LEVEL) continue;
-      
-      // Skip beaches and shores (at water's edge)
-      if (biome === BiomeID.beach || biome === BiomeID.snowy_beach || biome === BiomeID.stony_shore) continue;
-      
-      // Check if this biome supports trees
-      const treeType = getTreeTypeForBiome(biome, rng);
-      if (treeType === null) continue;
-      
-      // Check minimum distance from other trees (prevents overlap)
-      const minDistance = treeType === TreeType.Jungle ? 4 : 3;
-      let tooClose = false;
-      for (const existing of trees) {
-        const dx = existing.x - lx;
-        const dz = existing.z - lz;
-        if (dx * dx + dz * dz < minDistance * minDistance) {
-          tooClose = true;
-          break;
-        }
-      }
-      if (tooClose) continue;
-      
-      // Generate the full tree structure
-      const generatedTree = generateTree(treeType, rng);
-      
-      trees.push({
-        x: lx,
-        z: lz,
-        type: treeType,
-        height: generatedTree.trunkHeight,
-        blocks: generatedTree.blocks,
-      });
-      
-      placedCount++;
+        return BlockType.Grass;
     }
   }
 
@@ -582,6 +506,30 @@ export class ChunkGenerator {
     return this.generator.getBiomeAt(1, wx, 63, wz);
   }
 
+  /**
+   * Get biomes at many world positions in one batched query
+   */
+  getBiomesAt(xs: ArrayLike<number>, zs: ArrayLike<number>): Int32Array {
+    if (!this.generator) return new Int32Array(xs.length).fill(BiomeID.plains);
+    return this.generator.getBiomesAtPoints(1, xs, zs, 63);
+  }
+
+  /**
+   * Find a dry-land spawn column near the origin
+   * Spawnable biomes are the ones calculateHeight puts above sea level
+   * (everything but oceans and rivers), so no height check is needed.
+   */
+  findSpawn(maxRadius: number): { x: number; z: number } | null {
+    if (!this.generator) return null;
+    
+    const accept = new Uint8Array(256);
+    for (let biome = 0; biome < accept.length; biome++) {
+      const water = this.generator.isOcean(biome) || biome === BiomeID.river || biome === BiomeID.frozen_river;
+      accept[biome] = water ? 0 : 1;
+    }
+    return this.generator.findSpawn(maxRadius, accept);
+  }
+
   /**
    * Get terrain height at world position
    */
@@ -0,0 +1,91 @@
+/**
+ * Chunk Worker - runs ChunkGenerator off the main thread
+ * Owns its own cubiomes module instance. Chunk data comes back with its
+ * typed array buffers transferred, not copied.
+ */
+
+import { loadCubiomesModule } from '../cubiomes/wasm-bindings';
+import { ChunkGenerator, type ChunkData } from './ChunkGenerator';
+
+export type ChunkWorkerRequest =
+  | { type: 'init'; seed: number }
+  | { type: 'generate'; chunkX: number; chunkZ: number }
+  | { type: 'cancel'; chunkX: number; chunkZ: number };
+
+export type ChunkWorkerResponse =
+  | { type: 'ready' }
+  | { type: 'error'; message: string }
+  | { type: 'chunk'; chunkX: number; chunkZ: number; data: ChunkData };
+
+let generator: ChunkGenerator | null = null;
+
+// Requested chunks in arrival order; cancelled ones are removed before they run
+const queue = new Map<string, [number, number]>();
+let scheduled = false;
+
+function post(message: ChunkWorkerResponse, transfer: Transferable[] = []): void {
+  self.postMessage(message, { transfer });
+}
+
+/**
+ * Generate one queued chunk per task, so cancel messages that arrive
+ * in the meantime are handled before the next chunk starts
+ */
+function processNext(): void {
+  scheduled = false;
+  if (!generator) return;
+
+  const next = queue.entries().next();
+  if (next.done) return;
+
+  const [key, [chunkX, chunkZ]] = next.value;
+  queue.delete(key);
+
+  const data = generator.generateChunk(chunkX, chunkZ);
+  const arrays = [
+    data.heightMap,
+    data.biomeMap,
+    data.topBlock,
+    data.waterDepth,
+    data.rightNeighborHeights,
+    data.frontNeighborHeights,
+  ];
+  // Each array owns its own (non-shared) buffer, see WasmGenerator.readChunkSurface
+  post({ type: 'chunk', chunkX, chunkZ, data }, arrays.map((a) => a.buffer as ArrayBuffer));
+
+  schedule();
+}
+
+function schedule(): void {
+  if (scheduled || queue.size === 0) return;
+  scheduled = true;
+  setTimeout(processNext, 0);
+}
+
+self.onmessage = async (event: MessageEvent<ChunkWorkerRequest>) => {
+  const msg = event.data;
+
+  switch (msg.type) {
+    case 'init':
+      try {
+        // This worker is its own thread: no need for the threaded build
+        await loadCubiomesModule(false);
+        generator = new ChunkGenerator(msg.seed);
+        await generator.init();
+        post({ type: 'ready' });
+        schedule();
+      } catch (err) {
+        post({ type: 'error', message: err instanceof Error ? err.message : String(err) });
+      }
+      break;
+
+    case 'generate':
+      queue.set(`${msg.chunkX},${msg.chunkZ}`, [msg.chunkX, msg.chunkZ]);
+      schedule();
+      break;
+
+    case 'cancel':
+      queue.delete(`${msg.chunkX},${msg.chunkZ}`);
+      break;
+  }
+};
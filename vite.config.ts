@@ -1,11 +1,21 @@
 import { defineConfig } from 'vite';
 import { viteStaticCopy } from 'vite-plugin-static-copy';
 
+// Cross-origin isolation, required for SharedArrayBuffer (threaded cubiomes build)
+const crossOriginIsolationHeaders = {
+  'Cross-Origin-Opener-Policy': 'same-origin',
+  'Cross-Origin-Embedder-Policy': 'require-corp',
+};
+
 export default defineConfig({
   base: '/',
   server: {
     port: 3000,
     open: true,
+    headers: crossOriginIsolationHeaders,
+  },
+  preview: {
+    headers: crossOriginIsolationHeaders,
   },
   plugins: [
     viteStaticCopy({
@@ -16,6 +26,10 @@ export default defineConfig({
       ],
     }),
   ],
+  worker: {
+    // Chunk worker is a module worker (dynamic import of the cubiomes ES module)
+    format: 'es',
+  },
   build: {
     target: 'esnext',
     minify: 'esbuild',
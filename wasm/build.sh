@@ -20,26 +20,60 @@ $CUBIOMES_DIR/biomenoise.c
 $CUBIOMES_DIR/generator.c
 $CUBIOMES_DIR/finders.c
 $CUBIOMES_DIR/util.c
+seeded_noise.c
+tree_gen.c
+voxel_store.c
 cubiomes_wrapper.c
 "
 
 # Compile to WebAssembly
-echo "Compiling cubiomes to WebAssembly..."
-
-emcc $SOURCES \
-    -I"$CUBIOMES_DIR" \
-    -O3 \
-    -fwrapv \
-    -sWASM=1 \
-    -sMODULARIZE=1 \
-    -sEXPORT_NAME="CubiomesModule" \
-    -sEXPORTED_FUNCTIONS='["_init_generator", "_apply_seed", "_get_biome_at", "_gen_biomes_2d", "_alloc_biome_buffer", "_free_buffer", "_get_mc_version", "_is_ocean", "_is_snowy_biome", "_get_biome_color", "_get_biome_base_height", "_biome_has_trees", "_get_biome_grass_color", "_malloc", "_free"]' \
-    -sEXPORTED_RUNTIME_METHODS='["ccall", "cwrap", "getValue", "setValue"]' \
-    -sALLOW_MEMORY_GROWTH=1 \
-    -sINITIAL_MEMORY=33554432 \
-    -sNO_EXIT_RUNTIME=1 \
-    -sENVIRONMENT='web' \
-    -o "$OUTPUT_DIR/cubiomes.js"
+# build_variant <output name> [extra emcc flags/settings, applied last...]
+build_variant() {
+    local name="$1"
+    shift
+
+    echo "Compiling cubiomes to WebAssembly ($name)..."
+
+    emcc $SOURCES \
+        -I"$CUBIOMES_DIR" \
+        -O3 \
+        -fwrapv \
+        -ffp-contract=off \
+        -sWASM=1 \
+        -sMODULARIZE=1 \
+        -sEXPORT_ES6=1 \
+        -sEXPORT_NAME="CubiomesModule" \
+        -sEXPORTED_FUNCTIONS='["_create_generator", "_destroy_generator", "_generator_apply_seed", "_generator_configure", "_generator_snapshot_size", "_generator_snapshot", "_generator_restore", "_generator_seed_hi", "_generator_seed_lo", "_generator_dim", "_generator_get_biome_at", "_generator_point_buffer", "_get_biomes_at_points", "_get_spawn_table", "_find_spawn", "_get_tree_table", "_get_tree_surface", "_gen_chunk_trees", "_get_tree_templates", "_create_voxel_store", "_destroy_voxel_store", "_voxel_get", "_voxel_set", "_voxel_fill", "_voxel_column_top", "_voxel_chunk_blocks", "_generator_cache_hits", "_generator_cache_misses", "_generator_gen_biomes_2d", "_generator_gen_biomes_2d_u8", "_biome_pyramid_size", "_gen_biome_pyramid", "_get_render_palette", "_render_biome_rgba", "_gen_chunk_biomes_halo", "_gen_region_biomes", "_get_surface_table", "_configure_surface", "_gen_chunk_surface", "_gen_region_surfaces", "_gen_noise_grid", "_start_chunk_workers", "_stop_chunk_workers", "_submit_chunk", "_poll_completed", "_init_generator", "_apply_seed", "_get_biome_at", "_gen_biomes_2d", "_gen_biomes_2d_view", "_alloc_biome_buffer", "_free_buffer", "_get_mc_version", "_is_ocean", "_is_snowy_biome", "_get_biome_color", "_get_biome_base_height", "_biome_has_trees", "_get_biome_grass_color", "_get_biome_meta_table", "_malloc", "_free"]' \
+        -sEXPORTED_RUNTIME_METHODS='["ccall", "cwrap", "getValue", "setValue", "HEAP32", "HEAPU8", "HEAPF64"]' \
+        -sALLOW_MEMORY_GROWTH=1 \
+        -sINITIAL_MEMORY=33554432 \
+        -sNO_EXIT_RUNTIME=1 \
+        -sENVIRONMENT='web,worker,node' \
+        "$@" \
+        -o "$OUTPUT_DIR/$name.js"
+}
+
+# The loader in src/cubiomes/wasm-bindings.ts picks a variant at startup
+# by feature detection
+
+# Baseline build: runs everywhere
+build_variant cubiomes
+
+# simd128 build: vectorized noise kernels (and auto-vectorized cubiomes loops)
+build_variant cubiomes-simd -msimd128
+
+# Threaded build: background chunk workers (start_chunk_workers/submit_chunk).
+# Needs SharedArrayBuffer, so the page must be cross-origin isolated (see
+# vite.config.ts). Memory is fixed-size: JS reads HEAP views directly, and
+# growth triggered on a worker thread would leave those views stale.
+build_variant cubiomes-threads -msimd128 -pthread \
+    -sPTHREAD_POOL_SIZE=4 \
+    -sALLOW_MEMORY_GROWTH=0 \
+    -sINITIAL_MEMORY=134217728
+
+# No relaxed-simd variant: its only candidate op for the noise kernels is
+# relaxed madd, whose fused/unfused choice is up to the host and would break
+# bit-exact output across machines (hence -ffp-contract=off above)
 
 echo "Build complete! Output in $OUTPUT_DIR/"
 echo "Files generated:"
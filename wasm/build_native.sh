@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Build the cubiomes wrapper natively (gcc/clang, no Emscripten)
+# for benchmarking and determinism checks on a plain Linux box
+# Usage: ./build_native.sh && ./native/build/bench "$(git rev-parse --short HEAD)"
+#        ./native/build/golden check native/golden.txt
+#        (npm run check:determinism checks the same file from the JS side)
+
+set -e
+
+CUBIOMES_DIR="../../cubiomes"
+OUTPUT_DIR="native/build"
+CC="${CC:-cc}"
+
+# Create output directory
+mkdir -p "$OUTPUT_DIR"
+
+# Same sources as the WASM build (see build.sh)
+SOURCES="
+$CUBIOMES_DIR/noise.c
+$CUBIOMES_DIR/biomes.c
+$CUBIOMES_DIR/layers.c
+$CUBIOMES_DIR/biomenoise.c
+$CUBIOMES_DIR/generator.c
+$CUBIOMES_DIR/finders.c
+$CUBIOMES_DIR/util.c
+seeded_noise.c
+tree_gen.c
+voxel_store.c
+cubiomes_wrapper.c
+"
+
+# native/ comes first on the include path: its emscripten.h stands in for the real one
+echo "Compiling native benchmark with $CC..."
+
+$CC $SOURCES native/bench.c \
+    -Inative \
+    -I"$CUBIOMES_DIR" \
+    -I. \
+    -O3 \
+    -fwrapv \
+    -ffp-contract=off \
+    -lm \
+    -o "$OUTPUT_DIR/bench"
+
+echo "Compiling native determinism check with $CC..."
+
+$CC $SOURCES native/golden.c \
+    -Inative \
+    -I"$CUBIOMES_DIR" \
+    -I. \
+    -O3 \
+    -fwrapv \
+    -ffp-contract=off \
+    -lm \
+    -o "$OUTPUT_DIR/golden"
+
+echo "Build complete! Output in $OUTPUT_DIR/"
+ls -la "$OUTPUT_DIR"
@@ -5,13 +5,1636 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <emscripten.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <pthread.h>
+#endif
 #include "generator.h"
 #include "biomes.h"
+#include "seeded_noise.h"
+#include "tree_gen.h"
+#include "cubiomes_wrapper.h"
 
-// Global generator instance
-static Generator g_generator;
-static int g_initialized = 0;
+#define SURFACE_Y 63
+
+// Surface pass constants - must match ChunkGenerator.ts
+#define SEA_LEVEL 63
+#define SURFACE_HALO 1
+#define SURFACE_GRID (CHUNK_SIZE + 2 * SURFACE_HALO)
+#define SMOOTH_PASSES 3
+
+// Seeded generator states kept per handle for instant seed/dimension switches
+#define SNAPSHOT_LRU_SIZE 4
+#define SNAPSHOT_MAGIC 0x43534E50u  // "CSNP"
+
+// Biome tile cache: 4-way set associative, 256 tiles of 16x16 cells per handle
+#define BIOME_TILE_SHIFT 4
+#define BIOME_TILE_SIZE (1 << BIOME_TILE_SHIFT)
+#define BIOME_TILE_WAYS 4
+#define BIOME_TILE_SETS 64
+// Larger areas bypass the cache entirely so a big map doesn't flush it
+#define BIOME_TILE_MAX_AREA_TILES 64
+
+// Biome pyramid: level 0 is scale 4, each level above is 4x coarser (up to 256)
+#define PYRAMID_MAX_LEVELS 4
+
+// Biome map rendering (RENDER_HILLSHADE is in the header)
+#define HILLSHADE_STRENGTH 0.04  // Brightness change per block of height difference
+#define HILLSHADE_MIN 0.6
+#define HILLSHADE_MAX 1.4
+
+// Spawn search: coarse cells of SPAWN_COARSE_SCALE blocks, refined to 4 then 1
+#define SPAWN_COARSE_SCALE 16
+
+// Block IDs the surface pass picks itself - must match BlockType in src/world/types.ts
+#define BLOCK_GRASS 3
+#define BLOCK_WATER 6
+
+// Surface table marker: swamp column, water or grass depending on the patch noise
+#define SURFACE_SWAMP 0xFF
+
+// Noise fields for gen_noise_grid - must match NoiseField in wasm-bindings.ts
+#define NOISE_TERRAIN 0
+#define NOISE_SWAMP 1
+
+_Static_assert(sizeof(ChunkSurface) == 1056, "ChunkSurface layout is shared with wasm-bindings.ts");
+_Static_assert(sizeof(BiomeMetaTable) == 2816, "BiomeMetaTable layout is shared with wasm-bindings.ts");
+_Static_assert(sizeof(TreeTable) == 2816, "TreeTable layout is shared with wasm-bindings.ts");
+_Static_assert(sizeof(ChunkTrees) == 4 + 16 * MAX_CHUNK_TREES, "ChunkTrees layout is shared with wasm-bindings.ts");
+_Static_assert(sizeof(TreeTemplateTable) == 1732 + 4 * TREE_TYPE_COUNT * TREE_VARIANTS * MAX_TREE_BLOCKS,
+               "TreeTemplateTable layout is shared with wasm-bindings.ts");
+
+/**
+ * Seeded generator state plus the key it was built for
+ */
+struct GeneratorSnapshot {
+    uint32_t magic;
+    int mc_version;
+    uint32_t flags;
+    int dim;
+    uint64_t seed;
+    const struct GeneratorHandle* owner;
+    Generator g;
+};
+
+/**
+ * One cached tile of biomes at a given scale and y
+ */
+typedef struct {
+    int valid;
+    int scale;
+    int y;
+    int tx, tz;     // Tile coordinates (cell coordinate >> BIOME_TILE_SHIFT)
+    uint32_t used;  // LRU stamp
+    int biomes[BIOME_TILE_SIZE * BIOME_TILE_SIZE];
+} BiomeTile;
+
+/**
+ * A tile that missed once on a point query but was not filled
+ */
+typedef struct {
+    int valid;
+    int scale;
+    int y;
+    int tx, tz;
+} BiomeTileMiss;
+
+typedef struct {
+    BiomeTile tiles[BIOME_TILE_SETS][BIOME_TILE_WAYS];
+    BiomeTileMiss missed[BIOME_TILE_SETS];   // Last unfilled point miss per set
+    uint32_t clock;
+    uint32_t hits;
+    uint32_t misses;
+    int* scratch;   // genBiomes output + scratch for single-tile fills
+    size_t scratch_len;
+} BiomeTileCache;
+
+/**
+ * Generator handle - a cubiomes Generator plus the state that goes with it
+ * Handles share nothing, so the overworld, nether and end (or two seeds)
+ * can be generated side by side, and separate threads can each own one.
+ * JS only ever sees the pointer, as an opaque number.
+ */
+struct GeneratorHandle {
+    Generator g;
+    int initialized;
+    
+    // Configuration, kept so worker threads can build identical copies
+    int mc_version;
+    uint32_t flags;
+    uint64_t seed;
+    int dim;
+    int surface_seed;
+    
+    // Persistent output arena for biome generation
+    // Grown on demand and never freed, so chunk loading does no malloc/free
+    int* arena;
+    size_t arena_len;
+    
+    // Surface pass state (see configure_surface)
+    uint8_t surface_table[256];
+    SeededPerlin terrain_noise;
+    SeededPerlin swamp_noise;
+    int surface_ready;
+    double* noise_out;
+    size_t noise_out_len;
+    ChunkSurface* surfaces;
+    size_t surfaces_len;
+    
+    // Background chunk workers (pthreads builds only, see start_chunk_workers)
+    struct ChunkPool* pool;
+    
+    // Recently used seeded states (see generator_configure)
+    GeneratorSnapshot* snapshots[SNAPSHOT_LRU_SIZE];
+    uint32_t snapshot_used[SNAPSHOT_LRU_SIZE];
+    uint32_t snapshot_clock;
+    
+    // Recently generated biomes (see gen_area_cached), allocated on first use
+    BiomeTileCache* tile_cache;
+    
+    // Biomes find_spawn may pick (1 = acceptable), filled by JS
+    uint8_t spawn_table[256];
+    
+    // Tree rules, input surface and output for gen_chunk_trees (tables filled by JS)
+    TreeTable tree_table;
+    ChunkSurface tree_surface;
+    ChunkTrees* trees;
+    
+    // Custom colors for render_biome_rgba (0xRRGGBB per biome), filled by JS
+    uint32_t render_palette[256];
+    
+    // Point query buffers (see get_biomes_at_points)
+    int* points;
+    size_t points_len;
+    struct PointRef* point_order;
+    size_t point_order_len;
+};
+
+// Default handle backing the legacy single-generator API
+static GeneratorHandle g_default;
+
+/**
+ * Make sure a handle's output arena can hold at least len ints
+ * @return Arena pointer, or NULL if the allocation failed
+ */
+static int* ensure_arena(GeneratorHandle* h, size_t len) {
+    if (len > h->arena_len) {
+        int* grown = (int*)realloc(h->arena, len * sizeof(int));
+        if (!grown) return NULL;
+        h->arena = grown;
+        h->arena_len = len;
+    }
+    return h->arena;
+}
+
+/**
+ * Make sure a handle's surface arena can hold at least len chunk surfaces
+ */
+static ChunkSurface* ensure_surfaces(GeneratorHandle* h, size_t len) {
+    if (len > h->surfaces_len) {
+        ChunkSurface* grown = (ChunkSurface*)realloc(h->surfaces, len * sizeof(ChunkSurface));
+        if (!grown) return NULL;
+        h->surfaces = grown;
+        h->surfaces_len = len;
+    }
+    return h->surfaces;
+}
+
+/**
+ * Generate a 2D biome slice into a caller-provided buffer
+ */
+static int gen_area(const GeneratorHandle* h, int* buffer, int scale, int x, int z, int sx, int sz, int y) {
+    Range r;
+    r.scale = scale;
+    r.x = x;
+    r.z = z;
+    r.sx = sx;
+    r.sz = sz;
+    r.y = y;  // Keep y in block coordinates - genBiomes handles conversion
+    r.sy = 1;
+    
+    return genBiomes(&h->g, buffer, r);
+}
+
+/**
+ * SURFACE_Y as the y of a query at the given scale
+ * cubiomes reads y in blocks at scale 1 and in 4-block cells at every
+ * coarser scale (not in cells of the scale itself).
+ */
+static inline int surface_y(int scale) {
+    return scale == 1 ? SURFACE_Y : SURFACE_Y / 4;
+}
+
+// ============ Biome tile cache ============
+
+/**
+ * Get a handle's tile cache, allocating it on first use
+ * @return Cache, or NULL if it could not be allocated (callers then skip caching)
+ */
+static BiomeTileCache* get_tile_cache(GeneratorHandle* h) {
+    if (!h->tile_cache) {
+        h->tile_cache = (BiomeTileCache*)calloc(1, sizeof(BiomeTileCache));
+    }
+    return h->tile_cache;
+}
+
+/**
+ * Drop every cached tile (the generator's seed, dimension or version changed)
+ */
+static void clear_tile_cache(GeneratorHandle* h) {
+    BiomeTileCache* c = h->tile_cache;
+    if (!c) return;
+    for (int set = 0; set < BIOME_TILE_SETS; set++) {
+        for (int way = 0; way < BIOME_TILE_WAYS; way++) {
+            c->tiles[set][way].valid = 0;
+        }
+        c->missed[set].valid = 0;
+    }
+}
+
+static inline int tile_set(int scale, int y, int tx, int tz) {
+    uint32_t hash = (uint32_t)tx * 73856093u ^ (uint32_t)tz * 19349663u ^
+                    (uint32_t)scale * 83492791u ^ (uint32_t)y;
+    return (int)(hash & (BIOME_TILE_SETS - 1));
+}
+
+static BiomeTile* tile_lookup(BiomeTileCache* c, int scale, int y, int tx, int tz) {
+    BiomeTile* set = c->tiles[tile_set(scale, y, tx, tz)];
+    for (int way = 0; way < BIOME_TILE_WAYS; way++) {
+        BiomeTile* t = &set[way];
+        if (t->valid && t->tx == tx && t->tz == tz && t->scale == scale && t->y == y) {
+            t->used = ++c->clock;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Claim a slot for a tile, evicting the least recently used one in its set
+ * The caller fills in biomes.
+ */
+static BiomeTile* tile_insert(BiomeTileCache* c, int scale, int y, int tx, int tz) {
+    BiomeTile* set = c->tiles[tile_set(scale, y, tx, tz)];
+    BiomeTile* victim = &set[0];
+    for (int way = 0; way < BIOME_TILE_WAYS; way++) {
+        if (!set[way].valid) {
+            victim = &set[way];
+            break;
+        }
+        if (set[way].used < victim->used) victim = &set[way];
+    }
+    
+    victim->valid = 1;
+    victim->scale = scale;
+    victim->y = y;
+    victim->tx = tx;
+    victim->tz = tz;
+    victim->used = ++c->clock;
+    return victim;
+}
+
+/**
+ * Generate one tile and cache it
+ * @return Tile, or NULL on error
+ */
+static BiomeTile* tile_fill(GeneratorHandle* h, BiomeTileCache* c, int scale, int y, int tx, int tz) {
+    size_t len = getMinCacheSize(&h->g, scale, BIOME_TILE_SIZE, 1, BIOME_TILE_SIZE);
+    if (len > c->scratch_len) {
+        int* grown = (int*)realloc(c->scratch, len * sizeof(int));
+        if (!grown) return NULL;
+        c->scratch = grown;
+        c->scratch_len = len;
+    }
+    
+    if (gen_area(h, c->scratch, scale, tx * BIOME_TILE_SIZE, tz * BIOME_TILE_SIZE,
+                 BIOME_TILE_SIZE, BIOME_TILE_SIZE, y) != 0) {
+        return NULL;
+    }
+    BiomeTile* t = tile_insert(c, scale, y, tx, tz);
+    memcpy(t->biomes, c->scratch, sizeof(t->biomes));
+    return t;
+}
+
+/**
+ * Tile for point queries that missed the cache, or NULL to answer them with getBiomeAt
+ * A fill costs a whole 16x16 genBiomes, so it only pays off for tiles that
+ * are queried again: a lone point fills its tile on the second miss there,
+ * a batch with several points in the tile fills it right away.
+ * @param points - Points being answered from this tile
+ */
+static BiomeTile* tile_fill_on_repeat(GeneratorHandle* h, BiomeTileCache* c, int scale, int y, int tx, int tz, int points) {
+    BiomeTileMiss* m = &c->missed[tile_set(scale, y, tx, tz)];
+    int repeat = m->valid && m->tx == tx && m->tz == tz && m->scale == scale && m->y == y;
+    if (points < 2 && !repeat) {
+        m->valid = 1;
+        m->scale = scale;
+        m->y = y;
+        m->tx = tx;
+        m->tz = tz;
+        return NULL;
+    }
+    
+    m->valid = 0;
+    return tile_fill(h, c, scale, y, tx, tz);
+}
+
+/**
+ * gen_area served from / feeding the handle's tile cache
+ * An area whose tiles are all cached is copied out without touching
+ * cubiomes. Otherwise it is generated in one genBiomes call as before, and
+ * the whole tiles it covers are kept for later point and area queries.
+ * @param buffer - Output with room for getMinCacheSize(scale, sx, 1, sz) ints
+ */
+static int gen_area_cached(GeneratorHandle* h, int* buffer, int scale, int x, int z, int sx, int sz, int y) {
+    BiomeTileCache* c = get_tile_cache(h);
+    if (!c) return gen_area(h, buffer, scale, x, z, sx, sz, y);
+    
+    // Arithmetic shifts, so negative coordinates floor
+    int tx0 = x >> BIOME_TILE_SHIFT, tx1 = (x + sx - 1) >> BIOME_TILE_SHIFT;
+    int tz0 = z >> BIOME_TILE_SHIFT, tz1 = (z + sz - 1) >> BIOME_TILE_SHIFT;
+    if ((tx1 - tx0 + 1) * (tz1 - tz0 + 1) > BIOME_TILE_MAX_AREA_TILES) {
+        return gen_area(h, buffer, scale, x, z, sx, sz, y);
+    }
+    
+    int cached = 1;
+    for (int tz = tz0; tz <= tz1 && cached; tz++) {
+        for (int tx = tx0; tx <= tx1 && cached; tx++) {
+            cached = tile_lookup(c, scale, y, tx, tz) != NULL;
+        }
+    }
+    
+    if (cached) {
+        c->hits++;
+        for (int row = 0; row < sz; row++) {
+            int wz = z + row;
+            int tz = wz >> BIOME_TILE_SHIFT;
+            int lz = wz - tz * BIOME_TILE_SIZE;
+            for (int col = 0; col < sx; ) {
+                int wx = x + col;
+                int tx = wx >> BIOME_TILE_SHIFT;
+                int lx = wx - tx * BIOME_TILE_SIZE;
+                int run = BIOME_TILE_SIZE - lx;
+                if (run > sx - col) run = sx - col;
+                const BiomeTile* t = tile_lookup(c, scale, y, tx, tz);
+                memcpy(&buffer[row * sx + col], &t->biomes[lz * BIOME_TILE_SIZE + lx], run * sizeof(int));
+                col += run;
+            }
+        }
+        return 0;
+    }
+    
+    c->misses++;
+    int err = gen_area(h, buffer, scale, x, z, sx, sz, y);
+    if (err != 0) return err;
+    
+    // Keep every tile that lies wholly inside the area
+    for (int tz = tz0; tz <= tz1; tz++) {
+        int lz = tz * BIOME_TILE_SIZE - z;
+        if (lz < 0 || lz + BIOME_TILE_SIZE > sz) continue;
+        for (int tx = tx0; tx <= tx1; tx++) {
+            int lx = tx * BIOME_TILE_SIZE - x;
+            if (lx < 0 || lx + BIOME_TILE_SIZE > sx) continue;
+            if (tile_lookup(c, scale, y, tx, tz)) continue;
+            
+            BiomeTile* t = tile_insert(c, scale, y, tx, tz);
+            for (int row = 0; row < BIOME_TILE_SIZE; row++) {
+                memcpy(&t->biomes[row * BIOME_TILE_SIZE], &buffer[(lz + row) * sx + lx],
+                       BIOME_TILE_SIZE * sizeof(int));
+            }
+        }
+    }
+    return 0;
+}
+
+// ============ Handle-based API ============
+
+/**
+ * Create a generator for a specific Minecraft version
+ * @param mc_version - Minecraft version enum (e.g., MC_1_18 = 31)
+ * @param flags - Generator flags (0 for normal, 1 for large biomes)
+ * @return Opaque handle (must be released with destroy_generator), or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+GeneratorHandle* create_generator(int mc_version, uint32_t flags) {
+    GeneratorHandle* h = (GeneratorHandle*)calloc(1, sizeof(GeneratorHandle));
+    if (!h) return NULL;
+    setupGenerator(&h->g, mc_version, flags);
+    h->mc_version = mc_version;
+    h->flags = flags;
+    h->initialized = 1;
+    return h;
+}
+
+/**
+ * Release a handle created with create_generator
+ */
+EMSCRIPTEN_KEEPALIVE
+void destroy_generator(GeneratorHandle* h) {
+    if (!h || h == &g_default) return;
+    stop_chunk_workers(h);
+    free(h->arena);
+    free(h->surfaces);
+    free(h->noise_out);
+    for (int i = 0; i < SNAPSHOT_LRU_SIZE; i++) {
+        free(h->snapshots[i]);
+    }
+    if (h->tile_cache) {
+        free(h->tile_cache->scratch);
+        free(h->tile_cache);
+    }
+    free(h->points);
+    free(h->point_order);
+    free(h->trees);
+    free(h);
+}
+
+/**
+ * Apply a seed to a generator handle
+ * Seeds seen recently are restored from the handle's snapshot cache.
+ * @param seed_hi - High 32 bits of seed
+ * @param seed_lo - Low 32 bits of seed
+ * @param dim - Dimension (0 = overworld, -1 = nether, 1 = end)
+ */
+EMSCRIPTEN_KEEPALIVE
+void generator_apply_seed(GeneratorHandle* h, uint32_t seed_hi, uint32_t seed_lo, int dim) {
+    if (!h || !h->initialized) return;
+    generator_configure(h, h->mc_version, h->flags, seed_hi, seed_lo, dim);
+}
+
+// ============ Generator snapshots ============
+
+/**
+ * Size of the buffer generator_snapshot writes
+ */
+EMSCRIPTEN_KEEPALIVE
+int generator_snapshot_size(void) {
+    return (int)sizeof(GeneratorSnapshot);
+}
+
+/**
+ * Copy a handle's fully seeded state into a caller-owned buffer
+ * The Generator holds pointers into itself, so a snapshot can only be
+ * restored into the handle it was taken from.
+ * @param out - Buffer of generator_snapshot_size() bytes
+ * @return 0 on success, -1 if the handle is not initialized
+ */
+EMSCRIPTEN_KEEPALIVE
+int generator_snapshot(const GeneratorHandle* h, GeneratorSnapshot* out) {
+    if (!h || !h->initialized || !out) return -1;
+    out->magic = SNAPSHOT_MAGIC;
+    out->mc_version = h->mc_version;
+    out->flags = h->flags;
+    out->dim = h->dim;
+    out->seed = h->seed;
+    out->owner = h;
+    memcpy(&out->g, &h->g, sizeof(Generator));
+    return 0;
+}
+
+/**
+ * Restore a state taken with generator_snapshot (a memcpy, no noise setup)
+ * Switching to another world stops the handle's chunk workers, which hold
+ * a copy of the old one.
+ * @return 0 on success, -1 if the snapshot is invalid or from another handle
+ */
+EMSCRIPTEN_KEEPALIVE
+int generator_restore(GeneratorHandle* h, const GeneratorSnapshot* snap) {
+    if (!h || !snap || snap->magic != SNAPSHOT_MAGIC || snap->owner != h) return -1;
+    if (!h->initialized || snap->mc_version != h->mc_version || snap->flags != h->flags ||
+        snap->seed != h->seed || snap->dim != h->dim) {
+        clear_tile_cache(h);
+        stop_chunk_workers(h);
+    }
+    memcpy(&h->g, &snap->g, sizeof(Generator));
+    h->mc_version = snap->mc_version;
+    h->flags = snap->flags;
+    h->dim = snap->dim;
+    h->seed = snap->seed;
+    h->initialized = 1;
+    return 0;
+}
+
+/**
+ * Seed and dimension the handle is currently set to, e.g. after generator_restore
+ */
+EMSCRIPTEN_KEEPALIVE
+uint32_t generator_seed_hi(const GeneratorHandle* h) {
+    return h ? (uint32_t)(h->seed >> 32) : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t generator_seed_lo(const GeneratorHandle* h) {
+    return h ? (uint32_t)h->seed : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int generator_dim(const GeneratorHandle* h) {
+    return h ? h->dim : 0;
+}
+
+/**
+ * Switch a handle to any (version, flags, seed, dimension)
+ * Hits in the per-handle LRU are a memcpy; misses run setupGenerator (only
+ * if the version or flags changed) and applySeed, then evict the least
+ * recently used entry. Like generator_restore, a switch to another world
+ * stops the handle's chunk workers.
+ * @return 0 on success, -1 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int generator_configure(GeneratorHandle* h, int mc_version, uint32_t flags, uint32_t seed_hi, uint32_t seed_lo, int dim) {
+    if (!h) return -1;
+    uint64_t seed = ((uint64_t)seed_hi << 32) | seed_lo;
+    uint32_t now = ++h->snapshot_clock;
+    
+    int victim = 0;
+    for (int i = 0; i < SNAPSHOT_LRU_SIZE; i++) {
+        const GeneratorSnapshot* snap = h->snapshots[i];
+        if (snap && snap->mc_version == mc_version && snap->flags == flags &&
+            snap->seed == seed && snap->dim == dim) {
+            h->snapshot_used[i] = now;
+            return generator_restore(h, snap);
+        }
+        if (!snap || (h->snapshots[victim] && h->snapshot_used[i] < h->snapshot_used[victim])) {
+            victim = i;
+        }
+    }
+    
+    if (!h->initialized || h->mc_version != mc_version || h->flags != flags ||
+        h->seed != seed || h->dim != dim) {
+        stop_chunk_workers(h);
+    }
+    if (!h->initialized || h->mc_version != mc_version || h->flags != flags) {
+        setupGenerator(&h->g, mc_version, flags);
+        h->mc_version = mc_version;
+        h->flags = flags;
+        h->initialized = 1;
+    }
+    applySeed(&h->g, dim, seed);
+    h->seed = seed;
+    h->dim = dim;
+    clear_tile_cache(h);
+    
+    // Caching is best effort: a failed allocation only costs the next switch
+    if (!h->snapshots[victim]) {
+        h->snapshots[victim] = (GeneratorSnapshot*)malloc(sizeof(GeneratorSnapshot));
+    }
+    if (h->snapshots[victim]) {
+        generator_snapshot(h, h->snapshots[victim]);
+        h->snapshot_used[victim] = now;
+    }
+    return 0;
+}
+
+/**
+ * Get biome at a specific position
+ * @param scale - 1 for block coordinates, 4 for biome coordinates
+ * @param x, y, z - Position coordinates
+ * @return Biome ID, or -1 if the handle is not initialized
+ */
+EMSCRIPTEN_KEEPALIVE
+int generator_get_biome_at(GeneratorHandle* h, int scale, int x, int y, int z) {
+    if (!h || !h->initialized) return -1;
+    
+    BiomeTileCache* c = get_tile_cache(h);
+    if (!c) return getBiomeAt(&h->g, scale, x, y, z);
+    
+    int tx = x >> BIOME_TILE_SHIFT, tz = z >> BIOME_TILE_SHIFT;
+    BiomeTile* t = tile_lookup(c, scale, y, tx, tz);
+    if (t) {
+        c->hits++;
+    } else {
+        c->misses++;
+        t = tile_fill_on_repeat(h, c, scale, y, tx, tz, 1);
+        if (!t) return getBiomeAt(&h->g, scale, x, y, z);
+    }
+    return t->biomes[(z - tz * BIOME_TILE_SIZE) * BIOME_TILE_SIZE + (x - tx * BIOME_TILE_SIZE)];
+}
+
+/**
+ * Point query that never fills a tile: answered from a cached tile or by getBiomeAt
+ * For probes that rarely come back to a tile (the spawn search), where even
+ * a second-miss fill is usually wasted.
+ */
+static int get_biome_at_no_fill(GeneratorHandle* h, int scale, int x, int y, int z) {
+    BiomeTileCache* c = get_tile_cache(h);
+    if (c) {
+        int tx = x >> BIOME_TILE_SHIFT, tz = z >> BIOME_TILE_SHIFT;
+        const BiomeTile* t = tile_lookup(c, scale, y, tx, tz);
+        if (t) {
+            c->hits++;
+            return t->biomes[(z - tz * BIOME_TILE_SIZE) * BIOME_TILE_SIZE + (x - tx * BIOME_TILE_SIZE)];
+        }
+        c->misses++;
+    }
+    return getBiomeAt(&h->g, scale, x, y, z);
+}
+
+/**
+ * A point query, tagged with the tile it falls in (for grouping)
+ */
+struct PointRef {
+    int y, tx, tz;
+    int index;
+};
+
+static int compare_point_refs(const void* a, const void* b) {
+    const struct PointRef* p = (const struct PointRef*)a;
+    const struct PointRef* q = (const struct PointRef*)b;
+    if (p->y != q->y) return p->y < q->y ? -1 : 1;
+    if (p->tz != q->tz) return p->tz < q->tz ? -1 : 1;
+    if (p->tx != q->tx) return p->tx < q->tx ? -1 : 1;
+    return p->index - q->index;
+}
+
+/**
+ * Get a handle-owned buffer for get_biomes_at_points: xs, ys, zs and out,
+ * n ints each, back to back. Valid until the next call with a larger n.
+ * @return Pointer to 4 * n ints, or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int* generator_point_buffer(GeneratorHandle* h, int n) {
+    if (!h || n <= 0) return NULL;
+    size_t len = (size_t)n * 4;
+    if (len > h->points_len) {
+        int* grown = (int*)realloc(h->points, len * sizeof(int));
+        if (!grown) return NULL;
+        h->points = grown;
+        h->points_len = len;
+    }
+    return h->points;
+}
+
+/**
+ * Look up many scattered points in one call
+ * Points are grouped by cache tile (at scale 1 a tile is a 4x4 block of
+ * biome cells), so each group costs one tile lookup or one genBiomes fill
+ * shared by every point in it, whatever order the caller passed them in.
+ * A lone point in an uncached tile is answered like generator_get_biome_at.
+ * @param xs, ys, zs - Coordinates at the given scale, n each
+ * @param out - n biome IDs, in input order (-1 where generation failed)
+ * @return 0 on success, -1 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int get_biomes_at_points(GeneratorHandle* h, int scale, const int* xs, const int* ys, const int* zs, int n, int* out) {
+    if (!h || !h->initialized || n < 0 || (n > 0 && (!xs || !ys || !zs || !out))) return -1;
+    
+    BiomeTileCache* c = get_tile_cache(h);
+    if ((size_t)n > h->point_order_len) {
+        struct PointRef* grown = (struct PointRef*)realloc(h->point_order, (size_t)n * sizeof(struct PointRef));
+        if (grown) {
+            h->point_order = grown;
+            h->point_order_len = (size_t)n;
+        }
+    }
+    if (!c || (size_t)n > h->point_order_len) {
+        // No room to group - answer one by one
+        for (int i = 0; i < n; i++) {
+            out[i] = getBiomeAt(&h->g, scale, xs[i], ys[i], zs[i]);
+        }
+        return 0;
+    }
+    
+    struct PointRef* order = h->point_order;
+    for (int i = 0; i < n; i++) {
+        order[i].y = ys[i];
+        order[i].tx = xs[i] >> BIOME_TILE_SHIFT;
+        order[i].tz = zs[i] >> BIOME_TILE_SHIFT;
+        order[i].index = i;
+    }
+    qsort(order, (size_t)n, sizeof(struct PointRef), compare_point_refs);
+    
+    for (int start = 0; start < n; ) {
+        const struct PointRef* first = &order[start];
+        int end = start + 1;
+        while (end < n && order[end].y == first->y && order[end].tx == first->tx && order[end].tz == first->tz) {
+            end++;
+        }
+        
+        BiomeTile* t = tile_lookup(c, scale, first->y, first->tx, first->tz);
+        if (t) {
+            c->hits++;
+        } else {
+            c->misses++;
+            t = tile_fill_on_repeat(h, c, scale, first->y, first->tx, first->tz, end - start);
+        }
+        
+        for (int k = start; k < end; k++) {
+            int i = order[k].index;
+            if (t) {
+                int lx = xs[i] - first->tx * BIOME_TILE_SIZE;
+                int lz = zs[i] - first->tz * BIOME_TILE_SIZE;
+                out[i] = t->biomes[lz * BIOME_TILE_SIZE + lx];
+            } else {
+                out[i] = getBiomeAt(&h->g, scale, xs[i], ys[i], zs[i]);
+            }
+        }
+        start = end;
+    }
+    return 0;
+}
+
+/**
+ * Tile cache counters: lookups answered from cached tiles vs. ones that ran cubiomes
+ * (point queries count once each, area queries once per call)
+ */
+EMSCRIPTEN_KEEPALIVE
+uint32_t generator_cache_hits(const GeneratorHandle* h) {
+    return h && h->tile_cache ? h->tile_cache->hits : 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+uint32_t generator_cache_misses(const GeneratorHandle* h) {
+    return h && h->tile_cache ? h->tile_cache->misses : 0;
+}
+
+/**
+ * Generate biomes for a 2D area into the handle's output arena
+ * The arena is sized with getMinCacheSize, so it also has room for the
+ * scratch space genBiomes needs at scale 1 (voronoi source cells).
+ * The result stays valid until the next call that writes this handle's
+ * arena; JS reads it in place through a HEAP32 subarray.
+ * @param scale - Scale (1, 4, 16, 64, or 256)
+ * @param x, z - Starting position
+ * @param sx, sz - Size in x and z directions
+ * @param y - Y level (typically 63 for surface)
+ * @return Pointer to sx * sz biome IDs, or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int* generator_gen_biomes_2d(GeneratorHandle* h, int scale, int x, int z, int sx, int sz, int y) {
+    if (!h || !h->initialized || sx <= 0 || sz <= 0) return NULL;
+    
+    int* out = ensure_arena(h, getMinCacheSize(&h->g, scale, sx, 1, sz));
+    if (!out) return NULL;
+    
+    if (gen_area_cached(h, out, scale, x, z, sx, sz, y) != 0) return NULL;
+    return out;
+}
+
+/**
+ * Same as generator_gen_biomes_2d, but one byte per cell
+ * IDs are packed in place in the handle's arena right after generation, so
+ * JS copies (and keeps) a quarter of the bytes. Same lifetime rules.
+ * @return Pointer to sx * sz biome IDs (BIOME_U8_NONE for none), or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+uint8_t* generator_gen_biomes_2d_u8(GeneratorHandle* h, int scale, int x, int z, int sx, int sz, int y) {
+    int* ids = generator_gen_biomes_2d(h, scale, x, z, sx, sz, y);
+    if (!ids) return NULL;
+    
+    // Byte i never overlaps an int not yet read (i < 4i), so in place is safe
+    uint8_t* packed = (uint8_t*)ids;
+    size_t n = (size_t)sx * sz;
+    for (size_t i = 0; i < n; i++) {
+        int biome = ids[i];
+        packed[i] = (biome >= 0 && biome < BIOME_U8_NONE) ? (uint8_t)biome : BIOME_U8_NONE;
+    }
+    return packed;
+}
+
+/**
+ * Generate the scale-1 biomes of a chunk plus a border of halo blocks
+ * in a single genBiomes Range, so seam stitching and smoothing can read
+ * neighbor columns on all four sides without extra point queries.
+ * @param cx, cz - Chunk coordinates
+ * @param halo - Border width in blocks
+ * @return Pointer to (16 + 2*halo)^2 biome IDs in the handle's arena
+ *         (row-major, first cell at block (cx*16 - halo, cz*16 - halo)), or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int* gen_chunk_biomes_halo(GeneratorHandle* h, int cx, int cz, int halo) {
+    if (halo < 0) return NULL;
+    int size = CHUNK_SIZE + 2 * halo;
+    return generator_gen_biomes_2d(h, 1, cx * CHUNK_SIZE - halo, cz * CHUNK_SIZE - halo, size, size, SURFACE_Y);
+}
+
+/**
+ * Generate the scale-1 biomes of a rectangular region of chunks in one pass
+ * One large Range shares noise work across adjacent cells, so this is much
+ * cheaper than a Range per chunk; callers slice per-chunk views out of it.
+ * @param cx0, cz0 - Chunk coordinates of the region's top-left chunk
+ * @param ncx, ncz - Region size in chunks
+ * @param halo - Border width in blocks around the whole region
+ * @return Pointer to (ncx*16 + 2*halo) x (ncz*16 + 2*halo) biome IDs in the
+ *         handle's arena (row-major, first cell at block (cx0*16 - halo, cz0*16 - halo)),
+ *         or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int* gen_region_biomes(GeneratorHandle* h, int cx0, int cz0, int ncx, int ncz, int halo) {
+    if (halo < 0 || ncx <= 0 || ncz <= 0) return NULL;
+    int sx = ncx * CHUNK_SIZE + 2 * halo;
+    int sz = ncz * CHUNK_SIZE + 2 * halo;
+    return generator_gen_biomes_2d(h, 1, cx0 * CHUNK_SIZE - halo, cz0 * CHUNK_SIZE - halo, sx, sz, SURFACE_Y);
+}
+
+/**
+ * Cell range of a pyramid level covering level-0 cells [x, x + w)
+ */
+static void pyramid_level_range(int x, int w, int level, int* start, int* count) {
+    int shift = 2 * level;
+    // Arithmetic shifts, so negative coordinates floor
+    *start = x >> shift;
+    *count = ((x + w - 1) >> shift) - *start + 1;
+}
+
+/**
+ * Bytes gen_biome_pyramid writes for a region
+ * @return Size in bytes, or 0 for an invalid request (including one whose
+ *         size or far edge does not fit in an int)
+ */
+EMSCRIPTEN_KEEPALIVE
+int biome_pyramid_size(int x, int z, int w, int h, int levels) {
+    if (w <= 0 || h <= 0 || levels < 1 || levels > PYRAMID_MAX_LEVELS) return 0;
+    if ((int64_t)x + w > INT_MAX || (int64_t)z + h > INT_MAX) return 0;
+    int64_t total = 0;
+    for (int level = 0; level < levels; level++) {
+        int x0, nx, z0, nz;
+        pyramid_level_range(x, w, level, &x0, &nx);
+        pyramid_level_range(z, h, level, &z0, &nz);
+        total += (int64_t)nx * nz;
+        if (total > INT_MAX) return 0;
+    }
+    return (int)total;
+}
+
+static inline uint8_t pack_biome(int biome) {
+    return (biome >= 0 && biome < BIOME_U8_NONE) ? (uint8_t)biome : BIOME_U8_NONE;
+}
+
+/**
+ * Generate a biome mip chain over a region in one call
+ * Level 0 covers scale-4 cells [x, x + w) x [z, z + h); level n covers the
+ * same area at scale 4^(n+1), so a 4x4 block of level n-1 cells maps to one
+ * level n cell. Every level is sampled at the surface (y = 63 in blocks).
+ * 
+ * From 1.18 coarse levels are point-sampled from level 0: each cell takes
+ * the scale-4 cell at the center of its block (a point query for centers
+ * past the level-0 edge), which is where genBiomes samples the noise at
+ * those scales, so the whole chain costs one noise pass. Older versions
+ * gain nothing: every coarse level is its own genBiomes Range, run down the
+ * layer stack from the top, exactly as a generator_gen_biomes_2d call at
+ * that scale would be. "pyramid" lines in native/golden.txt compare each
+ * level with plain genBiomes at its scale.
+ * @param out - biome_pyramid_size() bytes; levels back to back, each row-major,
+ *              one byte per cell (BIOME_U8_NONE for none)
+ * @return 0 on success, -1 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int gen_biome_pyramid(GeneratorHandle* h, int x, int z, int w, int hgt, int levels, uint8_t* out) {
+    if (!h || !h->initialized || !out || biome_pyramid_size(x, z, w, hgt, levels) == 0) return -1;
+    
+    const int y = surface_y(4);
+    int* base = generator_gen_biomes_2d(h, 4, x, z, w, hgt, y);
+    if (!base) return -1;
+    
+    for (int i = 0; i < w * hgt; i++) {
+        out[i] = pack_biome(base[i]);
+    }
+    uint8_t* level_out = out + w * hgt;
+    
+    for (int level = 1; level < levels; level++) {
+        int x0, nx, z0, nz;
+        pyramid_level_range(x, w, level, &x0, &nx);
+        pyramid_level_range(z, hgt, level, &z0, &nz);
+        int scale = 4 << (2 * level);
+        
+        if (h->mc_version >= MC_1_18) {
+            int k = 1 << (2 * level);  // Scale-4 cells per level cell, per axis
+            for (int j = 0; j < nz; j++) {
+                int bz = (z0 + j) * k + k / 2;
+                for (int i = 0; i < nx; i++) {
+                    int bx = (x0 + i) * k + k / 2;
+                    int biome;
+                    if (bx >= x && bx < x + w && bz >= z && bz < z + hgt) {
+                        biome = base[(bz - z) * w + (bx - x)];
+                    } else {
+                        biome = generator_get_biome_at(h, 4, bx, y, bz);
+                    }
+                    level_out[j * nx + i] = pack_biome(biome);
+                }
+            }
+        } else {
+            // Own buffer: the handle arena still holds level 0
+            size_t len = getMinCacheSize(&h->g, scale, nx, 1, nz);
+            int* ids = (int*)malloc(len * sizeof(int));
+            if (!ids) return -1;
+            if (gen_area(h, ids, scale, x0, z0, nx, nz, y) != 0) {
+                free(ids);
+                return -1;
+            }
+            for (int i = 0; i < nx * nz; i++) {
+                level_out[i] = pack_biome(ids[i]);
+            }
+            free(ids);
+        }
+        level_out += nx * nz;
+    }
+    return 0;
+}
+
+// ============ Biome map rendering ============
+
+/**
+ * Custom palette for render_biome_rgba
+ * JS fills all 256 entries in place (0xRRGGBB per biome ID).
+ */
+EMSCRIPTEN_KEEPALIVE
+uint32_t* get_render_palette(GeneratorHandle* h) {
+    return h ? h->render_palette : NULL;
+}
+
+/**
+ * Rasterize a biome map straight to RGBA pixels
+ * Hillshading lights each cell from the north-west by the difference in
+ * biome base height, so mountains and ocean trenches read at a glance.
+ * @param scale - Blocks per pixel (1, 4, 16, 64 or 256)
+ * @param x, z - First cell at that scale
+ * @param w, hgt - Image size in pixels
+ * @param palette - 256 colors (0xRRGGBB, e.g. get_render_palette), or 0 for the built-in biome colors
+ * @param flags - RENDER_HILLSHADE to shade by base height
+ * @param out - w * hgt * 4 bytes, RGBA row-major (ready for ImageData)
+ * @return 0 on success, -1 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int render_biome_rgba(GeneratorHandle* h, int scale, int x, int z, int w, int hgt,
+                      const uint32_t* palette, int flags, uint8_t* out) {
+    if (!h || !h->initialized || !out || w <= 0 || hgt <= 0) return -1;
+    
+    const BiomeMetaTable* meta = get_biome_meta_table();
+    if (!palette) palette = meta->color;
+    
+    // One extra row and column on the north-west for the shading neighbors
+    int gw = w + 1;
+    int y = surface_y(scale);
+    const int* grid = generator_gen_biomes_2d(h, scale, x - 1, z - 1, gw, hgt + 1, y);
+    if (!grid) return -1;
+    
+    for (int j = 0; j < hgt; j++) {
+        const int* row = &grid[(j + 1) * gw + 1];
+        const int* above = &grid[j * gw];
+        uint8_t* px = &out[(size_t)j * w * 4];
+        
+        for (int i = 0; i < w; i++, px += 4) {
+            int biome = row[i];
+            uint32_t color = (biome >= 0 && biome < BIOME_META_COUNT) ? palette[biome] : 0;
+            int r = (color >> 16) & 0xFF;
+            int g = (color >> 8) & 0xFF;
+            int b = color & 0xFF;
+            
+            if (flags & RENDER_HILLSHADE) {
+                int nw = above[i];
+                int height = (biome >= 0 && biome < BIOME_META_COUNT) ? meta->base_height[biome] : 64;
+                int nw_height = (nw >= 0 && nw < BIOME_META_COUNT) ? meta->base_height[nw] : 64;
+                double shade = 1.0 + (height - nw_height) * HILLSHADE_STRENGTH;
+                if (shade < HILLSHADE_MIN) shade = HILLSHADE_MIN;
+                if (shade > HILLSHADE_MAX) shade = HILLSHADE_MAX;
+                r = (int)(r * shade);
+                g = (int)(g * shade);
+                b = (int)(b * shade);
+                if (r > 255) r = 255;
+                if (g > 255) g = 255;
+                if (b > 255) b = 255;
+            }
+            
+            px[0] = (uint8_t)r;
+            px[1] = (uint8_t)g;
+            px[2] = (uint8_t)b;
+            px[3] = 0xFF;
+        }
+    }
+    return 0;
+}
+
+// ============ Chunk surface pass ============
+
+/**
+ * Terrain height for a column
+ * Flat world: every biome sits at sea level (mirrors calculateSmoothHeight)
+ */
+static int surface_height(int wx, int wz, int biome) {
+    (void)wx; (void)wz; (void)biome;
+    return SEA_LEVEL;
+}
+
+// Swamp columns become water where the detail noise dips below this
+#define SWAMP_NOISE_SCALE 0.08
+#define SWAMP_WATER_THRESHOLD -0.3
+
+static inline int clamp_height(int height, int lo, int hi) {
+    return height < lo ? lo : height > hi ? hi : height;
+}
+
+/**
+ * Build one chunk's surface from a biome grid that has a SURFACE_HALO border
+ * @param grid - Biome IDs; the chunk's halo grid starts at grid[0]
+ * @param stride - Row stride of grid in ints
+ * @param wx0, wz0 - World block position of grid[0]
+ */
+static void build_surface(const GeneratorHandle* h, const int* grid, int stride, int wx0, int wz0, ChunkSurface* out) {
+    uint8_t heights[SURFACE_GRID * SURFACE_GRID];
+    
+    // Heights over the halo grid, biomes and heights for the interior
+    for (int gz = 0; gz < SURFACE_GRID; gz++) {
+        for (int gx = 0; gx < SURFACE_GRID; gx++) {
+            int biome = grid[gz * stride + gx];
+            int height = surface_height(wx0 + gx, wz0 + gz, biome);
+            heights[gz * SURFACE_GRID + gx] = (uint8_t)height;
+            
+            int lx = gx - SURFACE_HALO;
+            int lz = gz - SURFACE_HALO;
+            if (lx >= 0 && lx < CHUNK_SIZE && lz >= 0 && lz < CHUNK_SIZE) {
+                out->biome[lz * CHUNK_SIZE + lx] = (biome >= 0 && biome < BIOME_U8_NONE) ? (uint8_t)biome : BIOME_U8_NONE;
+                out->height[lz * CHUNK_SIZE + lx] = (uint8_t)height;
+            }
+        }
+    }
+    
+    // Neighbor columns for seam stitching come straight from the halo
+    for (int i = 0; i < CHUNK_SIZE; i++) {
+        out->right_heights[i] = heights[(i + SURFACE_HALO) * SURFACE_GRID + CHUNK_SIZE + SURFACE_HALO];
+        out->front_heights[i] = heights[(CHUNK_SIZE + SURFACE_HALO) * SURFACE_GRID + i + SURFACE_HALO];
+    }
+    
+    // Smoothing: limit each step to one block against its neighbors
+    // Edge columns compare against the halo so they match the adjacent chunk
+    for (int pass = 0; pass < SMOOTH_PASSES; pass++) {
+        for (int lz = 0; lz < CHUNK_SIZE; lz++) {
+            for (int lx = 0; lx < CHUNK_SIZE; lx++) {
+                int idx = lz * CHUNK_SIZE + lx;
+                int n = lz > 0 ? out->height[idx - CHUNK_SIZE] : heights[lx + SURFACE_HALO];
+                int s = lz < CHUNK_SIZE - 1 ? out->height[idx + CHUNK_SIZE] : out->front_heights[lx];
+                int w = lx > 0 ? out->height[idx - 1] : heights[(lz + SURFACE_HALO) * SURFACE_GRID];
+                int e = lx < CHUNK_SIZE - 1 ? out->height[idx + 1] : out->right_heights[lz];
+                
+                int lo = n < s ? n : s;
+                if (w < lo) lo = w;
+                if (e < lo) lo = e;
+                int hi = n > s ? n : s;
+                if (w > hi) hi = w;
+                if (e > hi) hi = e;
+                
+                out->height[idx] = (uint8_t)clamp_height(out->height[idx], lo - 1, hi + 1);
+            }
+        }
+    }
+    
+    // Top blocks from the per-biome surface table
+    int has_swamp = 0;
+    for (int idx = 0; idx < CHUNK_SIZE * CHUNK_SIZE; idx++) {
+        int biome = out->biome[idx];
+        int block = biome != BIOME_U8_NONE ? h->surface_table[biome] : BLOCK_GRASS;
+        has_swamp |= block == SURFACE_SWAMP;
+        out->top_block[idx] = (uint8_t)block;
+    }
+    
+    // Swamp water patches: one batch noise grid for the chunk, only when needed
+    if (has_swamp) {
+        double noise[CHUNK_SIZE * CHUNK_SIZE];
+        seeded_perlin_sample_grid(&h->swamp_noise, wx0 + SURFACE_HALO, wz0 + SURFACE_HALO,
+                                  CHUNK_SIZE, CHUNK_SIZE, SWAMP_NOISE_SCALE, noise);
+        for (int idx = 0; idx < CHUNK_SIZE * CHUNK_SIZE; idx++) {
+            if (out->top_block[idx] == SURFACE_SWAMP) {
+                out->top_block[idx] = noise[idx] < SWAMP_WATER_THRESHOLD ? BLOCK_WATER : BLOCK_GRASS;
+            }
+        }
+    }
+    
+    // Water surfaces sit at sea level like land, so no column is submerged
+    memset(out->water_depth, 0, sizeof(out->water_depth));
+}
+
+/**
+ * Biome -> top block table used by the surface pass
+ * JS fills all 256 entries in place (SURFACE_SWAMP marks swamp columns),
+ * then calls configure_surface.
+ */
+EMSCRIPTEN_KEEPALIVE
+uint8_t* get_surface_table(GeneratorHandle* h) {
+    return h ? h->surface_table : NULL;
+}
+
+/**
+ * Seed the surface pass noise the same way ChunkGenerator seeds its own
+ * Stops the handle's chunk workers: they copied the old seed and surface table.
+ * @param seed - ChunkGenerator seed (terrain noise uses it as is, swamp noise uses seed ^ 0x12345678)
+ */
+EMSCRIPTEN_KEEPALIVE
+void configure_surface(GeneratorHandle* h, int seed) {
+    if (!h) return;
+    stop_chunk_workers(h);
+    SeededRandom rng;
+    seeded_random_init(&rng, seed);
+    seeded_perlin_init(&h->terrain_noise, &rng);
+    seeded_random_init(&rng, seed ^ 0x12345678);
+    seeded_perlin_init(&h->swamp_noise, &rng);
+    h->surface_seed = seed;
+    h->surface_ready = 1;
+}
+
+/**
+ * Sample a grid of 2D noise in one call (batch version of PerlinNoise.sample2D)
+ * Cell (i, j) is sample2D((x0 + i) * scale, (z0 + j) * scale).
+ * @param noise - NOISE_TERRAIN or NOISE_SWAMP
+ * @param x0, z0 - World position of the first cell
+ * @param nx, nz - Grid size
+ * @return Pointer to nx * nz doubles in the handle's noise arena, or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+double* gen_noise_grid(GeneratorHandle* h, int noise, int x0, int z0, int nx, int nz, double scale) {
+    if (!h || !h->surface_ready || nx <= 0 || nz <= 0) return NULL;
+    
+    const SeededPerlin* p;
+    switch (noise) {
+        case NOISE_TERRAIN: p = &h->terrain_noise; break;
+        case NOISE_SWAMP:   p = &h->swamp_noise; break;
+        default: return NULL;
+    }
+    
+    size_t len = (size_t)nx * nz;
+    if (len > h->noise_out_len) {
+        double* grown = (double*)realloc(h->noise_out, len * sizeof(double));
+        if (!grown) return NULL;
+        h->noise_out = grown;
+        h->noise_out_len = len;
+    }
+    
+    seeded_perlin_sample_grid(p, x0, z0, nx, nz, scale, h->noise_out);
+    return h->noise_out;
+}
+
+/**
+ * Generate a chunk's biomes, heights, smoothing and top blocks in one call
+ * @param cx, cz - Chunk coordinates
+ * @return Pointer to a ChunkSurface in the handle's surface arena, valid until
+ *         the next surface call on this handle, or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+ChunkSurface* gen_chunk_surface(GeneratorHandle* h, int cx, int cz) {
+    if (!h || !h->surface_ready) return NULL;
+    
+    int* grid = gen_chunk_biomes_halo(h, cx, cz, SURFACE_HALO);
+    ChunkSurface* out = ensure_surfaces(h, 1);
+    if (!grid || !out) return NULL;
+    
+    build_surface(h, grid, SURFACE_GRID, cx * CHUNK_SIZE - SURFACE_HALO, cz * CHUNK_SIZE - SURFACE_HALO, out);
+    return out;
+}
+
+/**
+ * Generate the surfaces of a rectangular region of chunks from one biome pass
+ * @param cx0, cz0 - Chunk coordinates of the region's top-left chunk
+ * @param ncx, ncz - Region size in chunks
+ * @return Pointer to ncx * ncz ChunkSurfaces (row-major, chunk (cx0 + i, cz0 + j)
+ *         at index j * ncx + i), or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+ChunkSurface* gen_region_surfaces(GeneratorHandle* h, int cx0, int cz0, int ncx, int ncz) {
+    if (!h || !h->surface_ready) return NULL;
+    
+    int* grid = gen_region_biomes(h, cx0, cz0, ncx, ncz, SURFACE_HALO);
+    ChunkSurface* out = ensure_surfaces(h, (size_t)ncx * ncz);
+    if (!grid || !out) return NULL;
+    
+    int stride = ncx * CHUNK_SIZE + 2 * SURFACE_HALO;
+    for (int j = 0; j < ncz; j++) {
+        for (int i = 0; i < ncx; i++) {
+            const int* origin = grid + j * CHUNK_SIZE * stride + i * CHUNK_SIZE;
+            int wx0 = (cx0 + i) * CHUNK_SIZE - SURFACE_HALO;
+            int wz0 = (cz0 + j) * CHUNK_SIZE - SURFACE_HALO;
+            build_surface(h, origin, stride, wx0, wz0, &out[j * ncx + i]);
+        }
+    }
+    return out;
+}
+
+// ============ Tree placement ============
+
+/**
+ * Per-biome tree rules for gen_chunk_trees
+ * JS fills the whole table in place (see buildTreeTable in TreeGenerator.ts).
+ */
+EMSCRIPTEN_KEEPALIVE
+TreeTable* get_tree_table(GeneratorHandle* h) {
+    return h ? &h->tree_table : NULL;
+}
+
+/**
+ * Surface gen_chunk_trees places trees on
+ * JS copies the heights, top blocks and biomes of a chunk here; the
+ * other fields are not read.
+ */
+EMSCRIPTEN_KEEPALIVE
+ChunkSurface* get_tree_surface(GeneratorHandle* h) {
+    return h ? &h->tree_surface : NULL;
+}
+
+/**
+ * Place the trees of one chunk on the surface in get_tree_surface
+ * Uses the surface seed (see configure_surface). Each tree names one of
+ * the shared shapes in get_tree_templates.
+ * @return Trees of the chunk (valid until the next call), or NULL on error
+ */
+EMSCRIPTEN_KEEPALIVE
+ChunkTrees* gen_chunk_trees(GeneratorHandle* h, int cx, int cz) {
+    if (!h || !h->initialized || !h->surface_ready) return NULL;
+    if (!h->trees) {
+        h->trees = (ChunkTrees*)malloc(sizeof(ChunkTrees));
+        if (!h->trees) return NULL;
+    }
+    
+    tree_gen_chunk(&h->tree_table, h->surface_seed, cx, cz, &h->tree_surface, h->trees);
+    return h->trees;
+}
+
+/**
+ * Get the shared tree shapes (built on first use, like get_biome_meta_table)
+ * @return The template table, or NULL if a shape overflowed MAX_TREE_BLOCKS
+ */
+EMSCRIPTEN_KEEPALIVE
+const TreeTemplateTable* get_tree_templates(void) {
+    static TreeTemplateTable table;
+    static int built = 0;
+    
+    if (!built) {
+        if (tree_gen_templates(&table) < 0) return NULL;
+        built = 1;
+    }
+    return &table;
+}
+
+// ============ Spawn search ============
+
+/**
+ * Biome acceptance table for find_spawn
+ * JS fills all 256 entries in place (non-zero = a biome the player may spawn in).
+ */
+EMSCRIPTEN_KEEPALIVE
+uint8_t* get_spawn_table(GeneratorHandle* h) {
+    return h ? h->spawn_table : NULL;
+}
+
+typedef struct {
+    int x, z;       // Cell coordinates at the current scale
+    int64_t dist2;  // Squared distance of the cell center from the origin (blocks)
+} SpawnCell;
+
+static int spawn_accepts(const GeneratorHandle* h, int biome) {
+    return biome >= 0 && biome < 256 && h->spawn_table[biome];
+}
+
+static int64_t cell_dist2(int x, int z, int scale) {
+    int64_t cx = (int64_t)x * scale + scale / 2;
+    int64_t cz = (int64_t)z * scale + scale / 2;
+    return cx * cx + cz * cz;
+}
+
+static void sort_cells(SpawnCell* cells, int n) {
+    for (int i = 1; i < n; i++) {
+        SpawnCell cell = cells[i];
+        int j = i - 1;
+        while (j >= 0 && cells[j].dist2 > cell.dist2) {
+            cells[j + 1] = cells[j];
+            j--;
+        }
+        cells[j + 1] = cell;
+    }
+}
+
+/**
+ * Find an acceptable block inside an accepted cell, nearest the origin first
+ * Descends scale 16 -> 4 -> 1 with single-point lookups; the probes are
+ * scattered, so they read cached tiles but never fill new ones.
+ * @return 1 and the block in out_x/out_z, or 0 if no block in the cell qualifies
+ */
+static int refine_spawn(GeneratorHandle* h, int scale, int x, int z, int* out_x, int* out_z) {
+    if (scale == 1) {
+        *out_x = x;
+        *out_z = z;
+        return 1;
+    }
+    
+    SpawnCell children[16];
+    int sub = scale / 4;
+    int n = 0;
+    for (int j = 0; j < 4; j++) {
+        for (int i = 0; i < 4; i++) {
+            children[n].x = x * 4 + i;
+            children[n].z = z * 4 + j;
+            children[n].dist2 = cell_dist2(children[n].x, children[n].z, sub);
+            n++;
+        }
+    }
+    sort_cells(children, n);
+    
+    for (int k = 0; k < n; k++) {
+        int biome = get_biome_at_no_fill(h, sub, children[k].x, surface_y(sub), children[k].z);
+        if (spawn_accepts(h, biome) && refine_spawn(h, sub, children[k].x, children[k].z, out_x, out_z)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Find a spawn column near the origin
+ * Scans square rings of coarse cells outward (nearest cells of a ring
+ * first) and stops at the first accepted cell that refines down to an
+ * accepted block, so a typical world answers after a handful of queries.
+ * @param max_radius - Search radius in blocks
+ * @param out - Receives x, z (2 ints)
+ * @return 1 if found, 0 if nothing within max_radius qualifies, -1 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int find_spawn(GeneratorHandle* h, int max_radius, int* out) {
+    if (!h || !h->initialized || !out || max_radius < 0) return -1;
+    
+    // Cells are centered on the 2x2 block of cells around the origin
+    int rings = max_radius / SPAWN_COARSE_SCALE + 1;
+    // Ring r has 8r + 4 cells
+    SpawnCell* ring = (SpawnCell*)malloc(sizeof(SpawnCell) * (size_t)(8 * rings + 4));
+    if (!ring) return -1;
+    
+    int64_t limit = (int64_t)(max_radius + SPAWN_COARSE_SCALE) * (max_radius + SPAWN_COARSE_SCALE);
+    int found = 0;
+    for (int r = 0; r <= rings && !found; r++) {
+        // Perimeter of the square of cells at Chebyshev distance r, around cell (-1, -1)..(0, 0)
+        int n = 0;
+        for (int z = -r - 1; z <= r; z++) {
+            for (int x = -r - 1; x <= r; x++) {
+                int edge = x == -r - 1 || x == r || z == -r - 1 || z == r;
+                if (!edge) {
+                    x = r - 1;  // Skip the interior of the row
+                    continue;
+                }
+                ring[n].x = x;
+                ring[n].z = z;
+                ring[n].dist2 = cell_dist2(x, z, SPAWN_COARSE_SCALE);
+                n++;
+            }
+        }
+        sort_cells(ring, n);
+        
+        for (int k = 0; k < n && !found; k++) {
+            if (ring[k].dist2 > limit) break;
+            int biome = get_biome_at_no_fill(h, SPAWN_COARSE_SCALE, ring[k].x, surface_y(SPAWN_COARSE_SCALE), ring[k].z);
+            if (spawn_accepts(h, biome)) {
+                found = refine_spawn(h, SPAWN_COARSE_SCALE, ring[k].x, ring[k].z, &out[0], &out[1]);
+            }
+        }
+    }
+    
+    free(ring);
+    return found;
+}
+
+// ============ Background chunk workers (pthreads builds) ============
+
+#define CHUNK_JOB_CAPACITY 1024
+#define CHUNK_RESULT_CAPACITY 64
+#define MAX_CHUNK_WORKERS 16
+
+_Static_assert(sizeof(ChunkJobResult) == 16 + sizeof(ChunkSurface), "ChunkJobResult layout is shared with wasm-bindings.ts");
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+
+/**
+ * Fixed pool of worker threads, each with its own copy of the generator
+ * Jobs go in through a bounded queue; results come back through a bounded
+ * ring that lives in wasm memory (a SharedArrayBuffer in threaded builds).
+ * Only the main thread submits and polls, and it never waits on a condition:
+ * workers block when the result ring is full, the main thread only takes
+ * the lock for short copies.
+ */
+typedef struct ChunkPool {
+    pthread_mutex_t lock;
+    pthread_cond_t has_jobs;
+    pthread_cond_t has_room;
+    int stopping;
+    
+    int jobs[CHUNK_JOB_CAPACITY][2];
+    int job_head;
+    int job_count;
+    
+    ChunkJobResult results[CHUNK_RESULT_CAPACITY];
+    int result_head;
+    int result_count;
+    
+    // Consumer-owned copy handed out by poll_completed
+    ChunkJobResult polled;
+    
+    int thread_count;
+    pthread_t threads[MAX_CHUNK_WORKERS];
+    GeneratorHandle* workers[MAX_CHUNK_WORKERS];
+} ChunkPool;
+
+typedef struct {
+    ChunkPool* pool;
+    GeneratorHandle* h;
+} ChunkWorkerArgs;
+
+/**
+ * Build an independent handle with the same version, seed and surface setup
+ */
+static GeneratorHandle* clone_generator(const GeneratorHandle* src) {
+    GeneratorHandle* h = create_generator(src->mc_version, src->flags);
+    if (!h) return NULL;
+    
+    applySeed(&h->g, src->dim, src->seed);
+    h->seed = src->seed;
+    h->dim = src->dim;
+    memcpy(h->surface_table, src->surface_table, sizeof(h->surface_table));
+    configure_surface(h, src->surface_seed);
+    return h;
+}
+
+static void* chunk_worker_main(void* arg) {
+    ChunkWorkerArgs args = *(ChunkWorkerArgs*)arg;
+    free(arg);
+    ChunkPool* pool = args.pool;
+    
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stopping && pool->job_count == 0) {
+            pthread_cond_wait(&pool->has_jobs, &pool->lock);
+        }
+        if (pool->stopping) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        int cx = pool->jobs[pool->job_head][0];
+        int cz = pool->jobs[pool->job_head][1];
+        pool->job_head = (pool->job_head + 1) % CHUNK_JOB_CAPACITY;
+        pool->job_count--;
+        pthread_mutex_unlock(&pool->lock);
+        
+        // The heavy part runs unlocked, on this worker's own handle
+        ChunkSurface* surface = gen_chunk_surface(args.h, cx, cz);
+        
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stopping && pool->result_count == CHUNK_RESULT_CAPACITY) {
+            pthread_cond_wait(&pool->has_room, &pool->lock);
+        }
+        if (pool->stopping) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        ChunkJobResult* slot = &pool->results[(pool->result_head + pool->result_count) % CHUNK_RESULT_CAPACITY];
+        slot->cx = cx;
+        slot->cz = cz;
+        slot->ok = surface != NULL;
+        if (surface) slot->surface = *surface;
+        pool->result_count++;
+        pthread_mutex_unlock(&pool->lock);
+    }
+    
+    return NULL;
+}
+
+#endif
+
+/**
+ * Start background chunk workers for a handle
+ * Each worker gets its own copy of the generator, so call this after
+ * generator_apply_seed and configure_surface. Switching the handle to
+ * another world or calling configure_surface stops the workers (queued
+ * jobs and unpolled results are dropped); start them again afterwards.
+ * @param threads - Worker count (clamped to 1..MAX_CHUNK_WORKERS)
+ * @return Number of workers started; 0 in builds without pthreads
+ */
+EMSCRIPTEN_KEEPALIVE
+int start_chunk_workers(GeneratorHandle* h, int threads) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (!h || !h->initialized || !h->surface_ready) return 0;
+    stop_chunk_workers(h);
+    
+    if (threads < 1) threads = 1;
+    if (threads > MAX_CHUNK_WORKERS) threads = MAX_CHUNK_WORKERS;
+    
+    ChunkPool* pool = (ChunkPool*)calloc(1, sizeof(ChunkPool));
+    if (!pool) return 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->has_jobs, NULL);
+    pthread_cond_init(&pool->has_room, NULL);
+    h->pool = pool;
+    
+    for (int i = 0; i < threads; i++) {
+        GeneratorHandle* worker = clone_generator(h);
+        ChunkWorkerArgs* args = (ChunkWorkerArgs*)malloc(sizeof(ChunkWorkerArgs));
+        if (!worker || !args) {
+            destroy_generator(worker);
+            free(args);
+            break;
+        }
+        args->pool = pool;
+        args->h = worker;
+        if (pthread_create(&pool->threads[pool->thread_count], NULL, chunk_worker_main, args) != 0) {
+            destroy_generator(worker);
+            free(args);
+            break;
+        }
+        pool->workers[pool->thread_count++] = worker;
+    }
+    
+    if (pool->thread_count == 0) {
+        stop_chunk_workers(h);
+        return 0;
+    }
+    return pool->thread_count;
+#else
+    (void)h; (void)threads;
+    return 0;
+#endif
+}
+
+/**
+ * Stop and join a handle's chunk workers (no-op if none are running)
+ * Queued jobs and unpolled results are dropped.
+ */
+EMSCRIPTEN_KEEPALIVE
+void stop_chunk_workers(GeneratorHandle* h) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (!h || !h->pool) return;
+    ChunkPool* pool = h->pool;
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->has_jobs);
+    pthread_cond_broadcast(&pool->has_room);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (int i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+        destroy_generator(pool->workers[i]);
+    }
+    
+    pthread_cond_destroy(&pool->has_room);
+    pthread_cond_destroy(&pool->has_jobs);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+    h->pool = NULL;
+#else
+    (void)h;
+#endif
+}
+
+/**
+ * Queue a chunk for background generation
+ * @return 0 if queued, -1 if the queue is full or no workers are running
+ */
+EMSCRIPTEN_KEEPALIVE
+int submit_chunk(GeneratorHandle* h, int cx, int cz) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (!h || !h->pool) return -1;
+    ChunkPool* pool = h->pool;
+    
+    pthread_mutex_lock(&pool->lock);
+    if (pool->job_count == CHUNK_JOB_CAPACITY) {
+        pthread_mutex_unlock(&pool->lock);
+        return -1;
+    }
+    int tail = (pool->job_head + pool->job_count) % CHUNK_JOB_CAPACITY;
+    pool->jobs[tail][0] = cx;
+    pool->jobs[tail][1] = cz;
+    pool->job_count++;
+    pthread_cond_signal(&pool->has_jobs);
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+#else
+    (void)h; (void)cx; (void)cz;
+    return -1;
+#endif
+}
+
+/**
+ * Take the next finished chunk, if any (never blocks on the workers)
+ * @return Pointer to a ChunkJobResult valid until the next poll_completed
+ *         call on this handle, or 0 if nothing has finished yet
+ */
+EMSCRIPTEN_KEEPALIVE
+ChunkJobResult* poll_completed(GeneratorHandle* h) {
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (!h || !h->pool) return NULL;
+    ChunkPool* pool = h->pool;
+    ChunkJobResult* out = NULL;
+    
+    pthread_mutex_lock(&pool->lock);
+    if (pool->result_count > 0) {
+        pool->polled = pool->results[pool->result_head];
+        pool->result_head = (pool->result_head + 1) % CHUNK_RESULT_CAPACITY;
+        pool->result_count--;
+        pthread_cond_signal(&pool->has_room);
+        out = &pool->polled;
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return out;
+#else
+    (void)h;
+    return NULL;
+#endif
+}
+
+// ============ Legacy single-generator API (default handle) ============
 
 /**
  * Initialize the biome generator for a specific Minecraft version
@@ -20,8 +1643,11 @@ static int g_initialized = 0;
  */
 EMSCRIPTEN_KEEPALIVE
 void init_generator(int mc_version, uint32_t flags) {
-    setupGenerator(&g_generator, mc_version, flags);
-    g_initialized = 1;
+    setupGenerator(&g_default.g, mc_version, flags);
+    g_default.mc_version = mc_version;
+    g_default.flags = flags;
+    g_default.initialized = 1;
+    clear_tile_cache(&g_default);
 }
 
 /**
@@ -32,8 +1658,7 @@ void init_generator(int mc_version, uint32_t flags) {
  */
 EMSCRIPTEN_KEEPALIVE
 void apply_seed(uint32_t seed_hi, uint32_t seed_lo, int dim) {
-    uint64_t seed = ((uint64_t)seed_hi << 32) | seed_lo;
-    applySeed(&g_generator, dim, seed);
+    generator_apply_seed(&g_default, seed_hi, seed_lo, dim);
 }
 
 /**
@@ -44,8 +1669,7 @@ void apply_seed(uint32_t seed_hi, uint32_t seed_lo, int dim) {
  */
 EMSCRIPTEN_KEEPALIVE
 int get_biome_at(int scale, int x, int y, int z) {
-    if (!g_initialized) return -1;
-    return getBiomeAt(&g_generator, scale, x, y, z);
+    return generator_get_biome_at(&g_default, scale, x, y, z);
 }
 
 /**
@@ -60,18 +1684,17 @@ int get_biome_at(int scale, int x, int y, int z) {
  */
 EMSCRIPTEN_KEEPALIVE
 int gen_biomes_2d(int* buffer, int scale, int x, int z, int sx, int sz, int y) {
-    if (!g_initialized || !buffer) return -1;
-    
-    Range r;
-    r.scale = scale;
-    r.x = x;
-    r.z = z;
-    r.sx = sx;
-    r.sz = sz;
-    r.y = y;  // Keep y in block coordinates - genBiomes handles conversion
-    r.sy = 1;
-    
-    return genBiomes(&g_generator, buffer, r);
+    if (!g_default.initialized || !buffer) return -1;
+    return gen_area_cached(&g_default, buffer, scale, x, z, sx, sz, y);
+}
+
+/**
+ * Generate biomes for a 2D area into the default handle's output arena
+ * @return Pointer to sx * sz biome IDs, or 0 on error
+ */
+EMSCRIPTEN_KEEPALIVE
+int* gen_biomes_2d_view(int scale, int x, int z, int sx, int sz, int y) {
+    return generator_gen_biomes_2d(&g_default, scale, x, z, sx, sz, y);
 }
 
 /**
@@ -352,3 +1975,24 @@ uint32_t get_biome_grass_color(int biome_id) {
     }
 }
 
+/**
+ * Get the biome metadata table (filled from the helpers above on first use)
+ */
+EMSCRIPTEN_KEEPALIVE
+const BiomeMetaTable* get_biome_meta_table(void) {
+    static BiomeMetaTable table;
+    static int built = 0;
+    
+    if (!built) {
+        for (int id = 0; id < BIOME_META_COUNT; id++) {
+            table.color[id] = get_biome_color(id);
+            table.grass_color[id] = get_biome_grass_color(id);
+            table.base_height[id] = (uint8_t)get_biome_base_height(id);
+            table.trees[id] = (uint8_t)biome_has_trees(id);
+            table.flags[id] = (uint8_t)((is_ocean(id) ? BIOME_META_OCEAN : 0) |
+                                        (is_snowy_biome(id) ? BIOME_META_SNOWY : 0));
+        }
+        built = 1;
+    }
+    return &table;
+}
@@ -0,0 +1,239 @@
+/**
+ * Cubiomes WASM Wrapper - exported API
+ * Everything declared here is exported to JavaScript (see EXPORTED_FUNCTIONS
+ * in build.sh); native builds (benchmarks, determinism checks) link against
+ * the same functions.
+ */
+
+#ifndef CUBIOMES_WRAPPER_H
+#define CUBIOMES_WRAPPER_H
+
+#include <stdint.h>
+
+#define CHUNK_SIZE 16
+
+/**
+ * Opaque generator handle (see cubiomes_wrapper.c)
+ */
+typedef struct GeneratorHandle GeneratorHandle;
+
+/**
+ * Opaque copy of a seeded Generator (see generator_snapshot)
+ */
+typedef struct GeneratorSnapshot GeneratorSnapshot;
+
+// Biome IDs all fit in a byte; 8-bit outputs store cubiomes' "none" (-1) as this
+#define BIOME_U8_NONE 0xFF
+
+/**
+ * Surface of one chunk, as read back by WasmGenerator.readChunkSurface
+ * Byte layout is fixed (see CHUNK_SURFACE_* offsets in wasm-bindings.ts).
+ */
+typedef struct {
+    uint8_t height[CHUNK_SIZE * CHUNK_SIZE];
+    uint8_t top_block[CHUNK_SIZE * CHUNK_SIZE];
+    uint8_t water_depth[CHUNK_SIZE * CHUNK_SIZE];
+    uint8_t right_heights[CHUNK_SIZE];   // Heights of the +X neighbor's first column
+    uint8_t front_heights[CHUNK_SIZE];   // Heights of the +Z neighbor's first row
+    uint8_t biome[CHUNK_SIZE * CHUNK_SIZE];   // BIOME_U8_NONE where cubiomes had none
+} ChunkSurface;
+
+/**
+ * A finished chunk, as returned by poll_completed
+ * Byte layout is fixed (see CHUNK_RESULT_* offsets in wasm-bindings.ts).
+ */
+typedef struct {
+    int cx;
+    int cz;
+    int ok;      // 0 if generation failed (surface is undefined)
+    int pad;
+    ChunkSurface surface;
+} ChunkJobResult;
+
+/**
+ * Tree types - must match TreeType in src/world/types.ts
+ */
+#define TREE_OAK 0
+#define TREE_BIRCH 1
+#define TREE_SPRUCE 2
+#define TREE_JUNGLE 3
+#define TREE_ACACIA 4
+#define TREE_DARK_OAK 5
+#define TREE_CHERRY 6
+#define TREE_MANGROVE 7
+#define TREE_CACTUS 8
+#define TREE_TYPE_COUNT 9
+#define TREE_NONE 0xFF
+
+/**
+ * Per-biome tree rules, struct-of-arrays indexed by biome ID, filled by JS
+ * A column grows `primary`, or when `secondary` is set, primary with
+ * probability `chance` (one nextFloat) and secondary otherwise.
+ * Byte layout is fixed (see TREE_TABLE_* offsets in wasm-bindings.ts).
+ */
+typedef struct {
+    double chance[256];
+    uint8_t density[256];     // Target trees per chunk, by the chunk's center biome
+    uint8_t primary[256];     // TREE_* or TREE_NONE
+    uint8_t secondary[256];   // TREE_* or TREE_NONE
+} TreeTable;
+
+// Tree block records: tree-relative offsets biased by TREE_BLOCK_BIAS, kind in the top byte
+#define TREE_BLOCK_LOG 0
+#define TREE_BLOCK_LEAVES 1
+#define TREE_BLOCK_CACTUS 2
+#define TREE_BLOCK_BIAS 128
+#define TREE_BLOCK_PACK(dx, dy, dz, kind) \
+    ((uint32_t)((dx) + TREE_BLOCK_BIAS) | (uint32_t)((dy) + TREE_BLOCK_BIAS) << 8 | \
+     (uint32_t)((dz) + TREE_BLOCK_BIAS) << 16 | (uint32_t)(kind) << 24)
+
+#define MAX_CHUNK_TREES 16
+#define MAX_TREE_BLOCKS 320   // Largest shape (cherry) has at most 242 before deduplication
+#define TREE_VARIANTS 16      // Pre-built shapes per tree type
+
+/**
+ * Shared tree shapes: TREE_VARIANTS templates per tree type, built once
+ * Template (type, variant) is blocks[start .. start + count).
+ * Byte layout is fixed (see TREE_TEMPLATES_* offsets in wasm-bindings.ts).
+ */
+typedef struct {
+    int32_t start[TREE_TYPE_COUNT][TREE_VARIANTS];
+    int32_t count[TREE_TYPE_COUNT][TREE_VARIANTS];
+    int32_t height[TREE_TYPE_COUNT][TREE_VARIANTS];   // Trunk height
+    int32_t block_count;
+    uint32_t blocks[TREE_TYPE_COUNT * TREE_VARIANTS * MAX_TREE_BLOCKS];   // TREE_BLOCK_PACK records
+} TreeTemplateTable;
+
+/**
+ * One placed tree, drawn as template (type, variant)
+ */
+typedef struct {
+    int32_t x;        // Chunk-local column
+    int32_t z;
+    int32_t type;     // TREE_*
+    int32_t variant;
+} TreeRecord;
+
+/**
+ * Trees of one chunk, as read back by WasmGenerator.genChunkTrees
+ * Byte layout is fixed (see CHUNK_TREES_* offsets in wasm-bindings.ts).
+ */
+typedef struct {
+    int32_t tree_count;
+    TreeRecord trees[MAX_CHUNK_TREES];
+} ChunkTrees;
+
+// Handle-based API
+GeneratorHandle* create_generator(int mc_version, uint32_t flags);
+void destroy_generator(GeneratorHandle* h);
+void generator_apply_seed(GeneratorHandle* h, uint32_t seed_hi, uint32_t seed_lo, int dim);
+int generator_configure(GeneratorHandle* h, int mc_version, uint32_t flags, uint32_t seed_hi, uint32_t seed_lo, int dim);
+
+// Generator snapshots (restore only into the handle the snapshot came from)
+int generator_snapshot_size(void);
+int generator_snapshot(const GeneratorHandle* h, GeneratorSnapshot* out);
+int generator_restore(GeneratorHandle* h, const GeneratorSnapshot* snap);
+uint32_t generator_seed_hi(const GeneratorHandle* h);
+uint32_t generator_seed_lo(const GeneratorHandle* h);
+int generator_dim(const GeneratorHandle* h);
+int generator_get_biome_at(GeneratorHandle* h, int scale, int x, int y, int z);
+int* generator_point_buffer(GeneratorHandle* h, int n);
+int get_biomes_at_points(GeneratorHandle* h, int scale, const int* xs, const int* ys, const int* zs, int n, int* out);
+uint32_t generator_cache_hits(const GeneratorHandle* h);
+uint32_t generator_cache_misses(const GeneratorHandle* h);
+int* generator_gen_biomes_2d(GeneratorHandle* h, int scale, int x, int z, int sx, int sz, int y);
+uint8_t* generator_gen_biomes_2d_u8(GeneratorHandle* h, int scale, int x, int z, int sx, int sz, int y);
+int biome_pyramid_size(int x, int z, int w, int h, int levels);
+int gen_biome_pyramid(GeneratorHandle* h, int x, int z, int w, int hgt, int levels, uint8_t* out);
+int* gen_chunk_biomes_halo(GeneratorHandle* h, int cx, int cz, int halo);
+int* gen_region_biomes(GeneratorHandle* h, int cx0, int cz0, int ncx, int ncz, int halo);
+
+// Chunk surface pass
+uint8_t* get_surface_table(GeneratorHandle* h);
+void configure_surface(GeneratorHandle* h, int seed);
+double* gen_noise_grid(GeneratorHandle* h, int noise, int x0, int z0, int nx, int nz, double scale);
+ChunkSurface* gen_chunk_surface(GeneratorHandle* h, int cx, int cz);
+ChunkSurface* gen_region_surfaces(GeneratorHandle* h, int cx0, int cz0, int ncx, int ncz);
+
+// Tree placement (on the surface copied into get_tree_surface)
+TreeTable* get_tree_table(GeneratorHandle* h);
+ChunkSurface* get_tree_surface(GeneratorHandle* h);
+ChunkTrees* gen_chunk_trees(GeneratorHandle* h, int cx, int cz);
+const TreeTemplateTable* get_tree_templates(void);
+
+/**
+ * Voxel store: per-block world edits, keyed by world block position
+ * (see voxel_store.c). Values are 0..VOXEL_MAX_VALUE; JS stores BlockType.
+ */
+typedef struct VoxelStore VoxelStore;
+
+#define VOXEL_HEIGHT 128      // Must match MAX_HEIGHT in src/world/types.ts
+#define VOXEL_NONE (-1)       // Never edited
+#define VOXEL_MAX_VALUE 254
+#define VOXEL_CHUNK_CELLS (CHUNK_SIZE * VOXEL_HEIGHT * CHUNK_SIZE)
+
+// voxel_chunk_blocks records: chunk-local x and z, y, then the value
+#define VOXEL_RECORD_PACK(lx, y, lz, value) \
+    ((uint32_t)(lx) | (uint32_t)(lz) << 4 | (uint32_t)(y) << 8 | (uint32_t)(value) << 16)
+
+VoxelStore* create_voxel_store(void);
+void destroy_voxel_store(VoxelStore* s);
+int voxel_get(const VoxelStore* s, int x, int y, int z);
+int voxel_set(VoxelStore* s, int x, int y, int z, int value);
+int voxel_fill(VoxelStore* s, int x0, int y0, int z0, int x1, int y1, int z1, int value);
+int voxel_column_top(const VoxelStore* s, int x, int z, int ignore);
+const uint32_t* voxel_chunk_blocks(VoxelStore* s, int cx, int cz, int ignore);
+
+// Biome map rendering
+#define RENDER_HILLSHADE 1
+uint32_t* get_render_palette(GeneratorHandle* h);
+int render_biome_rgba(GeneratorHandle* h, int scale, int x, int z, int w, int hgt,
+                      const uint32_t* palette, int flags, uint8_t* out);
+
+// Spawn search
+uint8_t* get_spawn_table(GeneratorHandle* h);
+int find_spawn(GeneratorHandle* h, int max_radius, int* out);
+
+// Background chunk workers (pthreads builds)
+int start_chunk_workers(GeneratorHandle* h, int threads);
+void stop_chunk_workers(GeneratorHandle* h);
+int submit_chunk(GeneratorHandle* h, int cx, int cz);
+ChunkJobResult* poll_completed(GeneratorHandle* h);
+
+// Legacy single-generator API (default handle)
+void init_generator(int mc_version, uint32_t flags);
+void apply_seed(uint32_t seed_hi, uint32_t seed_lo, int dim);
+int get_biome_at(int scale, int x, int y, int z);
+int gen_biomes_2d(int* buffer, int scale, int x, int z, int sx, int sz, int y);
+int* gen_biomes_2d_view(int scale, int x, int z, int sx, int sz, int y);
+int* alloc_biome_buffer(int sx, int sz);
+void free_buffer(void* buffer);
+
+/**
+ * Per-biome metadata, struct-of-arrays indexed by biome ID.
+ * Built once; JS copies it and never calls the per-biome helpers below.
+ */
+#define BIOME_META_COUNT 256
+#define BIOME_META_OCEAN 0x01
+#define BIOME_META_SNOWY 0x02
+
+typedef struct {
+    uint32_t color[BIOME_META_COUNT];        // 0xRRGGBB
+    uint32_t grass_color[BIOME_META_COUNT];  // 0xRRGGBB
+    uint8_t base_height[BIOME_META_COUNT];
+    uint8_t trees[BIOME_META_COUNT];         // 0 none, 1 dense, 2 sparse
+    uint8_t flags[BIOME_META_COUNT];         // BIOME_META_*
+} BiomeMetaTable;
+
+const BiomeMetaTable* get_biome_meta_table(void);
+
+// Biome helpers
+int get_mc_version(int major, int minor);
+int is_ocean(int biome_id);
+int is_snowy_biome(int biome_id);
+uint32_t get_biome_color(int biome_id);
+int get_biome_base_height(int biome_id);
+int biome_has_trees(int biome_id);
+uint32_t get_biome_grass_color(int biome_id);
+
+#endif
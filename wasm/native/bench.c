@@ -0,0 +1,231 @@
+/**
+ * Native benchmark for the cubiomes wrapper
+ * Prints one JSON object per line, so results can be diffed or collected
+ * per commit:
+ *   {"bench":"gen_biomes_2d","label":"...","mc":"1.20","seed":42,"scale":4,"cells_per_sec":...}
+ *
+ * Usage: bench [label]   (label defaults to "local", e.g. pass a commit hash)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "generator.h"
+#include "cubiomes_wrapper.h"
+
+typedef struct {
+    const char* name;
+    int mc;
+} BenchVersion;
+
+static const BenchVersion VERSIONS[] = {
+    { "1.12", MC_1_12 },
+    { "1.16", MC_1_16 },
+    { "1.18", MC_1_18 },
+    { "1.20", MC_1_20 },
+};
+
+static const int64_t SEEDS[] = { 0, 42, 123456789, -4172144997902289642LL };
+
+// Area per scale, so each pass covers a similar amount of work
+static const struct { int scale; int size; } SCALES[] = {
+    { 1, 256 }, { 4, 256 }, { 16, 128 }, { 64, 64 }, { 256, 32 },
+};
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+static const char* g_label = "local";
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void seed_default(int64_t seed) {
+    uint64_t s = (uint64_t)seed;
+    apply_seed((uint32_t)(s >> 32), (uint32_t)s, 0);
+}
+
+static void print_result(const char* bench, const BenchVersion* v, int64_t seed, const char* metric, double value, int scale) {
+    printf("{\"bench\":\"%s\",\"label\":\"%s\",\"mc\":\"%s\",\"seed\":%lld", bench, g_label, v->name, (long long)seed);
+    if (scale > 0) printf(",\"scale\":%d", scale);
+    printf(",\"%s\":%.3f}\n", metric, value);
+    fflush(stdout);
+}
+
+/**
+ * Cost of setupGenerator and applySeed
+ */
+static void bench_setup(const BenchVersion* v) {
+    const int iterations = 200;
+    
+    double t0 = now_sec();
+    for (int i = 0; i < iterations; i++) {
+        init_generator(v->mc, 0);
+    }
+    double t1 = now_sec();
+    print_result("init_generator", v, 0, "ns_per_call", (t1 - t0) * 1e9 / iterations, 0);
+    
+    // A new seed every call, so the handle's snapshot LRU never hits
+    t0 = now_sec();
+    for (int i = 0; i < iterations; i++) {
+        seed_default(1000000 + i);   // Not in SEEDS
+    }
+    t1 = now_sec();
+    print_result("apply_seed", v, 0, "ns_per_call", (t1 - t0) * 1e9 / iterations, 0);
+    
+    // Switching between two recent seeds is an LRU hit (a snapshot memcpy)
+    seed_default(SEEDS[0]);
+    seed_default(SEEDS[1]);
+    t0 = now_sec();
+    for (int i = 0; i < iterations; i++) {
+        seed_default(SEEDS[i & 1]);
+    }
+    t1 = now_sec();
+    print_result("apply_seed_cached", v, 0, "ns_per_call", (t1 - t0) * 1e9 / iterations, 0);
+}
+
+/**
+ * gen_biomes_2d throughput over a few areas, including negative coordinates
+ */
+static void bench_gen_biomes(const BenchVersion* v, int64_t seed) {
+    static const int ORIGINS[][2] = { { 0, 0 }, { -4096, 2048 }, { 100000, -70000 } };
+    
+    for (size_t si = 0; si < COUNT(SCALES); si++) {
+        int scale = SCALES[si].scale;
+        int size = SCALES[si].size;
+        int* buffer = alloc_biome_buffer(size, size);
+        if (!buffer) continue;
+        
+        double cells = 0;
+        double t0 = now_sec();
+        for (size_t oi = 0; oi < COUNT(ORIGINS); oi++) {
+            int x = ORIGINS[oi][0] / scale;
+            int z = ORIGINS[oi][1] / scale;
+            if (gen_biomes_2d(buffer, scale, x, z, size, size, 63) == 0) {
+                cells += (double)size * size;
+            }
+        }
+        double t1 = now_sec();
+        
+        free_buffer(buffer);
+        print_result("gen_biomes_2d", v, seed, "cells_per_sec", cells / (t1 - t0), scale);
+    }
+}
+
+/**
+ * Point query latency at block and biome scale
+ */
+static void bench_get_biome_at(const BenchVersion* v, int64_t seed) {
+    const int queries = 2000;
+    static const int QUERY_SCALES[] = { 1, 4 };
+    
+    for (size_t si = 0; si < COUNT(QUERY_SCALES); si++) {
+        int scale = QUERY_SCALES[si];
+        int y = 63 / scale;   // Sea level, in cells of the query scale
+        uint32_t rng = 12345;
+        volatile int sink = 0;
+        
+        double t0 = now_sec();
+        for (int i = 0; i < queries; i++) {
+            rng = rng * 1664525u + 1013904223u;
+            int x = (int)(rng >> 8) % 20000 - 10000;
+            rng = rng * 1664525u + 1013904223u;
+            int z = (int)(rng >> 8) % 20000 - 10000;
+            sink += get_biome_at(scale, x / scale, y, z / scale);
+        }
+        double t1 = now_sec();
+        (void)sink;
+        
+        print_result("get_biome_at", v, seed, "ns_per_call", (t1 - t0) * 1e9 / queries, scale);
+    }
+}
+
+/**
+ * Spawn search latency, accepting any land biome like the game's default table
+ */
+static void bench_find_spawn(const BenchVersion* v, int64_t seed) {
+    const int iterations = 20;
+    GeneratorHandle* h = create_generator(v->mc, 0);
+    if (!h) return;
+    
+    uint64_t s = (uint64_t)seed;
+    generator_apply_seed(h, (uint32_t)(s >> 32), (uint32_t)s, 0);
+    uint8_t* accept = get_spawn_table(h);
+    for (int id = 0; id < 256; id++) {
+        accept[id] = !is_ocean(id) && id != river && id != frozen_river;
+    }
+    
+    // Cold cache every call, as for a newly loaded world: a seed switch drops
+    // the handle's tiles (both seeds are snapshot LRU hits, kept out of the timing)
+    uint64_t other = s + 1;
+    int pos[2];
+    double elapsed = 0;
+    for (int i = 0; i < iterations; i++) {
+        generator_apply_seed(h, (uint32_t)(other >> 32), (uint32_t)other, 0);
+        generator_apply_seed(h, (uint32_t)(s >> 32), (uint32_t)s, 0);
+        double t0 = now_sec();
+        find_spawn(h, 1000, pos);   // Game3D searches 1000 blocks
+        elapsed += now_sec() - t0;
+    }
+    print_result("find_spawn", v, seed, "ns_per_call", elapsed * 1e9 / iterations, 0);
+    // Every probe is one tile lookup (hit or miss)
+    double probes = (double)generator_cache_hits(h) + generator_cache_misses(h);
+    print_result("find_spawn", v, seed, "probes_per_call", probes / iterations, 0);
+    
+    destroy_generator(h);
+}
+
+/**
+ * Chunk surface throughput through the handle API (biomes + surface pass)
+ */
+static void bench_chunk_surface(const BenchVersion* v, int64_t seed) {
+    GeneratorHandle* h = create_generator(v->mc, 0);
+    if (!h) return;
+    
+    uint64_t s = (uint64_t)seed;
+    generator_apply_seed(h, (uint32_t)(s >> 32), (uint32_t)s, 0);
+    configure_surface(h, (int)seed);
+    
+    const int radius = 8;
+    int chunks = 0;
+    double t0 = now_sec();
+    for (int cz = -radius; cz < radius; cz++) {
+        for (int cx = -radius; cx < radius; cx++) {
+            if (gen_chunk_surface(h, cx, cz)) chunks++;
+        }
+    }
+    double t1 = now_sec();
+    print_result("gen_chunk_surface", v, seed, "chunks_per_sec", chunks / (t1 - t0), 0);
+    
+    t0 = now_sec();
+    ChunkSurface* region = gen_region_surfaces(h, -radius, -radius, 2 * radius, 2 * radius);
+    t1 = now_sec();
+    if (region) {
+        print_result("gen_region_surfaces", v, seed, "chunks_per_sec", 4.0 * radius * radius / (t1 - t0), 0);
+    }
+    
+    destroy_generator(h);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) g_label = argv[1];
+    
+    for (size_t vi = 0; vi < COUNT(VERSIONS); vi++) {
+        const BenchVersion* v = &VERSIONS[vi];
+        bench_setup(v);
+        
+        for (size_t si = 0; si < COUNT(SEEDS); si++) {
+            init_generator(v->mc, 0);
+            seed_default(SEEDS[si]);
+            bench_gen_biomes(v, SEEDS[si]);
+            bench_get_biome_at(v, SEEDS[si]);
+            bench_find_spawn(v, SEEDS[si]);
+            bench_chunk_surface(v, SEEDS[si]);
+        }
+    }
+    
+    return 0;
+}
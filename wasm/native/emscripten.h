@@ -0,0 +1,11 @@
+/**
+ * Stand-in for <emscripten.h> in native (non-Emscripten) builds
+ * The wrapper only needs EMSCRIPTEN_KEEPALIVE, which is meaningless natively.
+ */
+
+#ifndef NATIVE_EMSCRIPTEN_H
+#define NATIVE_EMSCRIPTEN_H
+
+#define EMSCRIPTEN_KEEPALIVE
+
+#endif
@@ -0,0 +1,486 @@
+/**
+ * Determinism check for the cubiomes wrapper
+ * Hashes biome grids and chunk surfaces over a fixed matrix of versions,
+ * seeds, scales and coordinates (negative ones included) and compares the
+ * digests with a recorded golden file, so fast paths can be swapped in
+ * without silently changing world output.
+ *
+ * Usage: golden record <file> [kind...]   write the digests (native/golden.txt);
+ *                                         with kinds, replace only those kinds' lines
+ *        golden check <file>              compare; exits 1 on any mismatch
+ *
+ * Lines are "<kind> <key=value...> fnv=<16 hex digits>" (64-bit FNV-1a over
+ * the little-endian output bytes). src/debug/DeterminismCheck.ts computes
+ * the same "biomes", "pyramid", "surface", "noise" and tree lines from JS and adds JS-only
+ * kinds; unknown kinds are ignored here, as are lines starting with '#'.
+ *
+ * "biomes" lines are recorded from plain genBiomes on a fresh Generator, the
+ * way gen_biomes_2d worked before the wrapper had arenas or caches, and
+ * checked through the wrapper - so they can be recorded on any checkout.
+ * "pyramid" lines work the same way: recorded from genBiomes at each level's
+ * scale, checked against gen_biome_pyramid (whose 1.18+ coarse levels are
+ * point-sampled from level 0).
+ * Every kind needs golden lines: check fails on a kind with none at all.
+ * Single digests with no line are only counted (a matrix entry can be added
+ * before it is recorded).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "generator.h"
+#include "cubiomes_wrapper.h"
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+#define MAX_LINE 256
+#define MAX_LINES 4096
+#define MAX_KINDS 16
+
+// Matrix - keep in sync with DeterminismCheck.ts
+static const int MINORS[] = { 12, 16, 18, 20 };
+static const int64_t SEEDS[] = { 0, 42, -1, -4172144997902289642LL };
+static const int SCALES[] = { 1, 4, 16, 64, 256 };
+static const int ORIGINS[][2] = { { 0, 0 }, { -40, -24 }, { 123, -456 } };
+static const int GRID_SIZE = 48;
+static const int CHUNKS[][2] = { { 0, 0 }, { -1, -1 }, { 7, -3 }, { -20, 11 } };
+static const double NOISE_SCALES[] = { 0.005, 0.08 };   // Terrain height and swamp patch scales
+// Far chunks included: the chunk seed is computed in double math
+static const int TREE_CHUNKS[][2] = { { 0, 0 }, { -1, -1 }, { 7, -3 }, { -20, 11 }, { 6250, -4375 }, { -100000, 99999 } };
+
+// gen_biome_pyramid levels (scales 4 to 256), sampled at y = 63 in 4-block cells
+#define PYRAMID_LEVELS 4
+#define PYRAMID_Y (63 / 4)
+
+// Biome ID of swamp, the one table entry using the noise marker
+#define GOLDEN_SWAMP_BIOME 6
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+
+/**
+ * Synthetic surface table, so the surface pass is checked independently of
+ * the game's biome classification: block = biome % 40, swamp uses the noise
+ */
+static void fill_surface_table(GeneratorHandle* h) {
+    uint8_t* table = get_surface_table(h);
+    for (int i = 0; i < 256; i++) {
+        table[i] = (uint8_t)(i % 40);
+    }
+    table[GOLDEN_SWAMP_BIOME] = 0xFF;
+}
+
+/**
+ * Synthetic tree rules: every tree type, with and without a secondary type
+ */
+static void fill_tree_table(GeneratorHandle* h) {
+    TreeTable* table = get_tree_table(h);
+    for (int i = 0; i < 256; i++) {
+        table->chance[i] = 0.6;
+        table->density[i] = (uint8_t)(i % 12);
+        table->primary[i] = i % 10 == 9 ? TREE_NONE : (uint8_t)(i % TREE_TYPE_COUNT);
+        table->secondary[i] = i % 3 == 0 ? (uint8_t)((i + 4) % TREE_TYPE_COUNT) : TREE_NONE;
+    }
+}
+
+/**
+ * Synthetic tree input for a chunk (an LCG seeded from its coordinates),
+ * so placement is checked without cubiomes or the surface pass
+ */
+static void fill_tree_surface(GeneratorHandle* h, int cx, int cz) {
+    ChunkSurface* surface = get_tree_surface(h);
+    uint32_t r = (uint32_t)cx * 73856093u ^ (uint32_t)cz * 19349663u;
+    for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+        r = r * 1664525u + 1013904223u;
+        surface->height[i] = (uint8_t)(56 + (r >> 24) % 24);
+        surface->top_block[i] = (uint8_t)((r >> 16) % 11);
+        surface->biome[i] = (uint8_t)(r >> 8);
+    }
+}
+
+/**
+ * Digest of a biome grid from plain genBiomes (no wrapper arenas or caches)
+ * @return Digest, or 0 on error
+ */
+static uint64_t reference_biomes(const Generator* g, int scale, int x, int z, int sx, int sz, int y) {
+    Range r;
+    r.scale = scale;
+    r.x = x;
+    r.z = z;
+    r.sx = sx;
+    r.sz = sz;
+    r.y = y;
+    r.sy = 1;
+    
+    int* ids = allocCache(g, r);
+    if (!ids) return 0;
+    uint64_t hash = genBiomes(g, ids, r) == 0 ? fnv1a(FNV_OFFSET, ids, sizeof(int) * (size_t)sx * sz) : 0;
+    free(ids);
+    return hash;
+}
+
+/**
+ * Digests of the levels of a biome pyramid from plain genBiomes, one Range
+ * per level, packed to bytes as gen_biome_pyramid packs them
+ * @param hashes - PYRAMID_LEVELS digests (0 on error)
+ */
+static void reference_pyramid(const Generator* g, int x, int z, int w, int h, uint64_t* hashes) {
+    for (int level = 0; level < PYRAMID_LEVELS; level++) {
+        int shift = 2 * level;
+        Range r;
+        r.scale = 4 << shift;
+        r.x = x >> shift;
+        r.z = z >> shift;
+        r.sx = ((x + w - 1) >> shift) - r.x + 1;
+        r.sz = ((z + h - 1) >> shift) - r.z + 1;
+        r.y = PYRAMID_Y;
+        r.sy = 1;
+        
+        hashes[level] = 0;
+        int* ids = allocCache(g, r);
+        if (!ids) continue;
+        if (genBiomes(g, ids, r) == 0) {
+            uint8_t* packed = (uint8_t*)ids;   // In place, as generator_gen_biomes_2d_u8 does
+            size_t n = (size_t)r.sx * r.sz;
+            for (size_t i = 0; i < n; i++) {
+                packed[i] = (ids[i] >= 0 && ids[i] < BIOME_U8_NONE) ? (uint8_t)ids[i] : BIOME_U8_NONE;
+            }
+            hashes[level] = fnv1a(FNV_OFFSET, packed, n);
+        }
+        free(ids);
+    }
+}
+
+/**
+ * Digests of the levels of gen_biome_pyramid
+ * @param hashes - PYRAMID_LEVELS digests (0 on error)
+ */
+static void wrapper_pyramid(GeneratorHandle* handle, int x, int z, int w, int h, uint64_t* hashes) {
+    memset(hashes, 0, sizeof(uint64_t) * PYRAMID_LEVELS);
+    int size = biome_pyramid_size(x, z, w, h, PYRAMID_LEVELS);
+    uint8_t* out = size > 0 ? (uint8_t*)malloc((size_t)size) : NULL;
+    if (!out) return;
+    if (gen_biome_pyramid(handle, x, z, w, h, PYRAMID_LEVELS, out) == 0) {
+        const uint8_t* level_out = out;
+        for (int level = 0; level < PYRAMID_LEVELS; level++) {
+            int shift = 2 * level;
+            size_t n = (size_t)(((x + w - 1) >> shift) - (x >> shift) + 1) *
+                       (size_t)(((z + h - 1) >> shift) - (z >> shift) + 1);
+            hashes[level] = fnv1a(FNV_OFFSET, level_out, n);
+            level_out += n;
+        }
+    }
+    free(out);
+}
+
+/**
+ * @param reference - Compute "biomes" and "pyramid" from plain genBiomes
+ *                    (recording) instead of through the wrapper (checking)
+ */
+static int collect_digests(char lines[][MAX_LINE], int reference) {
+    static Generator ref;
+    int n = 0;
+    
+    for (size_t vi = 0; vi < COUNT(MINORS); vi++) {
+        int mc = get_mc_version(1, MINORS[vi]);
+        
+        for (size_t si = 0; si < COUNT(SEEDS); si++) {
+            int64_t seed = SEEDS[si];
+            uint64_t s = (uint64_t)seed;
+            GeneratorHandle* h = create_generator(mc, 0);
+            if (!h) continue;
+            generator_apply_seed(h, (uint32_t)(s >> 32), (uint32_t)s, 0);
+            if (reference) {
+                setupGenerator(&ref, mc, 0);
+                applySeed(&ref, DIM_OVERWORLD, s);
+            }
+            
+            for (size_t ci = 0; ci < COUNT(SCALES); ci++) {
+                for (size_t oi = 0; oi < COUNT(ORIGINS); oi++) {
+                    int x = ORIGINS[oi][0], z = ORIGINS[oi][1];
+                    uint64_t hash;
+                    if (reference) {
+                        hash = reference_biomes(&ref, SCALES[ci], x, z, GRID_SIZE, GRID_SIZE, 63);
+                    } else {
+                        int* grid = generator_gen_biomes_2d(h, SCALES[ci], x, z, GRID_SIZE, GRID_SIZE, 63);
+                        hash = grid ? fnv1a(FNV_OFFSET, grid, sizeof(int) * GRID_SIZE * GRID_SIZE) : 0;
+                    }
+                    snprintf(lines[n++], MAX_LINE, "biomes mc=1.%d seed=%lld scale=%d x=%d z=%d size=%d fnv=%016llx",
+                             MINORS[vi], (long long)seed, SCALES[ci], x, z, GRID_SIZE, (unsigned long long)hash);
+                }
+            }
+            
+            // Origins are in scale-4 cells here
+            for (size_t oi = 0; oi < COUNT(ORIGINS); oi++) {
+                int x = ORIGINS[oi][0], z = ORIGINS[oi][1];
+                uint64_t hashes[PYRAMID_LEVELS];
+                if (reference) {
+                    reference_pyramid(&ref, x, z, GRID_SIZE, GRID_SIZE, hashes);
+                } else {
+                    wrapper_pyramid(h, x, z, GRID_SIZE, GRID_SIZE, hashes);
+                }
+                for (int level = 0; level < PYRAMID_LEVELS; level++) {
+                    snprintf(lines[n++], MAX_LINE, "pyramid mc=1.%d seed=%lld level=%d x=%d z=%d size=%d fnv=%016llx",
+                             MINORS[vi], (long long)seed, level, x, z, GRID_SIZE, (unsigned long long)hashes[level]);
+                }
+            }
+            
+            fill_surface_table(h);
+            configure_surface(h, (int)seed);
+            for (size_t ci = 0; ci < COUNT(CHUNKS); ci++) {
+                int cx = CHUNKS[ci][0], cz = CHUNKS[ci][1];
+                ChunkSurface* surface = gen_chunk_surface(h, cx, cz);
+                uint64_t hash = surface ? fnv1a(FNV_OFFSET, surface, sizeof(ChunkSurface)) : 0;
+                snprintf(lines[n++], MAX_LINE, "surface mc=1.%d seed=%lld cx=%d cz=%d fnv=%016llx",
+                         MINORS[vi], (long long)seed, cx, cz, (unsigned long long)hash);
+            }
+            
+            destroy_generator(h);
+        }
+    }
+    
+    // Surface noise does not depend on the version: one handle per seed
+    for (size_t si = 0; si < COUNT(SEEDS); si++) {
+        GeneratorHandle* h = create_generator(get_mc_version(1, 20), 0);
+        if (!h) continue;
+        configure_surface(h, (int)SEEDS[si]);
+        
+        for (int field = 0; field < 2; field++) {   // NOISE_TERRAIN, NOISE_SWAMP
+            for (size_t ci = 0; ci < COUNT(NOISE_SCALES); ci++) {
+                for (size_t oi = 0; oi < COUNT(ORIGINS); oi++) {
+                    int x = ORIGINS[oi][0], z = ORIGINS[oi][1];
+                    double* grid = gen_noise_grid(h, field, x, z, GRID_SIZE, GRID_SIZE, NOISE_SCALES[ci]);
+                    uint64_t hash = grid
+                        ? fnv1a(FNV_OFFSET, grid, sizeof(double) * GRID_SIZE * GRID_SIZE)
+                        : 0;
+                    snprintf(lines[n++], MAX_LINE, "noise seed=%lld field=%d scale=%g x=%d z=%d size=%d fnv=%016llx",
+                             (long long)SEEDS[si], field, NOISE_SCALES[ci], x, z, GRID_SIZE, (unsigned long long)hash);
+                }
+            }
+        }
+        destroy_generator(h);
+    }
+    
+    // Tree placement: positions and types, on synthetic input
+    for (size_t si = 0; si < COUNT(SEEDS); si++) {
+        GeneratorHandle* h = create_generator(get_mc_version(1, 20), 0);
+        if (!h) continue;
+        configure_surface(h, (int)SEEDS[si]);
+        fill_tree_table(h);
+        
+        for (size_t ci = 0; ci < COUNT(TREE_CHUNKS); ci++) {
+            int cx = TREE_CHUNKS[ci][0], cz = TREE_CHUNKS[ci][1];
+            fill_tree_surface(h, cx, cz);
+            ChunkTrees* trees = gen_chunk_trees(h, cx, cz);
+            uint64_t hash = 0;
+            if (trees) {
+                int32_t count = trees->tree_count;
+                hash = fnv1a(FNV_OFFSET, &count, sizeof(count));
+                for (int k = 0; k < count; k++) {
+                    const TreeRecord* tree = &trees->trees[k];
+                    int32_t fields[3] = { tree->x, tree->z, tree->type };
+                    hash = fnv1a(hash, fields, sizeof(fields));
+                }
+            }
+            snprintf(lines[n++], MAX_LINE, "trees seed=%lld cx=%d cz=%d fnv=%016llx",
+                     (long long)SEEDS[si], cx, cz, (unsigned long long)hash);
+            
+            // Shape choice, kept apart so a shape change doesn't hide a placement change
+            hash = 0;
+            if (trees) {
+                int32_t count = trees->tree_count;
+                hash = fnv1a(FNV_OFFSET, &count, sizeof(count));
+                for (int k = 0; k < count; k++) {
+                    int32_t variant = trees->trees[k].variant;
+                    hash = fnv1a(hash, &variant, sizeof(variant));
+                }
+            }
+            snprintf(lines[n++], MAX_LINE, "variants seed=%lld cx=%d cz=%d fnv=%016llx",
+                     (long long)SEEDS[si], cx, cz, (unsigned long long)hash);
+        }
+        destroy_generator(h);
+    }
+    
+    // Tree shapes, per type: trunk height, then blocks, of every variant in order
+    const TreeTemplateTable* templates = get_tree_templates();
+    for (int type = 0; type < TREE_TYPE_COUNT; type++) {
+        uint64_t hash = 0;
+        if (templates) {
+            hash = FNV_OFFSET;
+            for (int variant = 0; variant < TREE_VARIANTS; variant++) {
+                int32_t header[2] = { templates->height[type][variant], templates->count[type][variant] };
+                hash = fnv1a(hash, header, sizeof(header));
+                hash = fnv1a(hash, templates->blocks + templates->start[type][variant],
+                             sizeof(uint32_t) * (size_t)templates->count[type][variant]);
+            }
+        }
+        snprintf(lines[n++], MAX_LINE, "templates type=%d variants=%d fnv=%016llx",
+                 type, TREE_VARIANTS, (unsigned long long)hash);
+    }
+    
+    return n;
+}
+
+/**
+ * Split a line into key part and digest; returns 0 if it has no digest
+ */
+static int split_line(const char* line, char* key, size_t key_len, char* digest, size_t digest_len) {
+    const char* at = strstr(line, " fnv=");
+    if (!at) return 0;
+    size_t len = (size_t)(at - line);
+    if (len >= key_len) return 0;
+    memcpy(key, line, len);
+    key[len] = '\0';
+    snprintf(digest, digest_len, "%.16s", at + 5);
+    return 1;
+}
+
+/**
+ * Copy a line's kind (its first word) into kind
+ */
+static void line_kind(const char* line, char* kind, size_t len) {
+    size_t k = strcspn(line, " \n");
+    if (k >= len) k = len - 1;
+    memcpy(kind, line, k);
+    kind[k] = '\0';
+}
+
+static int has_kind(const char* line, char* const* kinds, int kind_count) {
+    char kind[MAX_LINE];
+    line_kind(line, kind, sizeof(kind));
+    for (int i = 0; i < kind_count; i++) {
+        if (strcmp(kind, kinds[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Write the digests; with kinds, keep every other line of the file as it is
+ */
+static int record(const char* path, char lines[][MAX_LINE], int n, char* const* kinds, int kind_count) {
+    static char kept[MAX_LINES][MAX_LINE];
+    int kept_count = 0;
+    if (kind_count > 0) {
+        FILE* f = fopen(path, "r");
+        char line[MAX_LINE];
+        while (f && kept_count < MAX_LINES && fgets(line, sizeof(line), f)) {
+            line[strcspn(line, "\n")] = '\0';
+            if (line[0] == '#' || !has_kind(line, kinds, kind_count)) {
+                snprintf(kept[kept_count++], MAX_LINE, "%s", line);
+            }
+        }
+        if (f) fclose(f);
+    }
+    
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 2;
+    }
+    for (int i = 0; i < kept_count; i++) {
+        fprintf(f, "%s\n", kept[i]);
+    }
+    int written = 0;
+    for (int i = 0; i < n; i++) {
+        if (kind_count > 0 && !has_kind(lines[i], kinds, kind_count)) continue;
+        fprintf(f, "%s\n", lines[i]);
+        written++;
+    }
+    fclose(f);
+    printf("Recorded %d digests to %s\n", written, path);
+    return 0;
+}
+
+static int check(const char* path, char lines[][MAX_LINE], int n) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "No golden file at %s - run 'golden record %s' on a known-good build\n", path, path);
+        return 2;
+    }
+    
+    int checked = 0, failed = 0;
+    static char matched[MAX_LINES];
+    memset(matched, 0, sizeof(matched));
+    char golden_kinds[MAX_KINDS][MAX_LINE];
+    int golden_kind_count = 0;
+    char golden[MAX_LINE];
+    while (fgets(golden, sizeof(golden), f)) {
+        char gkey[MAX_LINE], gdigest[32];
+        if (golden[0] == '#') continue;
+        if (!split_line(golden, gkey, sizeof(gkey), gdigest, sizeof(gdigest))) continue;
+        
+        char kind[MAX_LINE];
+        line_kind(golden, kind, sizeof(kind));
+        int known = 0;
+        for (int k = 0; k < golden_kind_count; k++) {
+            known |= strcmp(golden_kinds[k], kind) == 0;
+        }
+        if (!known && golden_kind_count < MAX_KINDS) {
+            memcpy(golden_kinds[golden_kind_count++], kind, sizeof(kind));
+        }
+        
+        for (int i = 0; i < n; i++) {
+            char key[MAX_LINE], digest[32];
+            if (!split_line(lines[i], key, sizeof(key), digest, sizeof(digest))) continue;
+            if (strcmp(key, gkey) != 0) continue;
+            
+            checked++;
+            matched[i] = 1;
+            if (strcmp(digest, gdigest) != 0) {
+                failed++;
+                printf("MISMATCH %s: expected %s, got %s\n", key, gdigest, digest);
+            }
+            break;
+        }
+    }
+    fclose(f);
+    
+    int unrecorded = 0;
+    for (int i = 0; i < n; i++) {
+        unrecorded += !matched[i];
+    }
+    
+    // A kind with no golden lines at all checks nothing: fail instead of passing
+    char missing[MAX_KINDS][MAX_LINE];
+    int missing_count = 0;
+    for (int i = 0; i < n; i++) {
+        char kind[MAX_LINE];
+        line_kind(lines[i], kind, sizeof(kind));
+        int seen = 0;
+        for (int k = 0; k < golden_kind_count; k++) seen |= strcmp(golden_kinds[k], kind) == 0;
+        for (int k = 0; k < missing_count; k++) seen |= strcmp(missing[k], kind) == 0;
+        if (!seen && missing_count < MAX_KINDS) {
+            memcpy(missing[missing_count++], kind, sizeof(kind));
+            printf("UNRECORDED kind %s: no golden lines (see 'golden record <file> %s')\n", kind, kind);
+        }
+    }
+    
+    printf("%d digests checked, %d mismatched, %d not in the golden file, %d kinds unrecorded\n",
+           checked, failed, unrecorded, missing_count);
+    if (checked == 0) return 2;
+    return failed || missing_count ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    int recording = argc >= 3 && strcmp(argv[1], "record") == 0;
+    if (!recording && (argc != 3 || strcmp(argv[1], "check") != 0)) {
+        fprintf(stderr, "Usage: %s record <golden file> [kind...] | check <golden file>\n", argv[0]);
+        return 2;
+    }
+    
+    static char lines[MAX_LINES][MAX_LINE];
+    int n = collect_digests(lines, recording);
+    
+    if (recording) {
+        return record(argv[2], lines, n, argv + 3, argc - 3);
+    }
+    return check(argv[2], lines, n);
+}
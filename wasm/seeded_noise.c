@@ -0,0 +1,259 @@
+/**
+ * Seeded noise - C port of SeededRandom and PerlinNoise from src/cubiomes/noise.ts
+ * Keep the operation order identical to the TypeScript code: results must
+ * match bit for bit (build with -ffp-contract=off).
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include "seeded_noise.h"
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#define GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
+
+static uint32_t splitmix_next(uint64_t* s) {
+    *s += GOLDEN_GAMMA;
+    uint64_t z = *s;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t)(z ^ (z >> 31));
+}
+
+void seeded_random_init(SeededRandom* r, int64_t seed) {
+    uint64_t s = (uint64_t)seed ^ GOLDEN_GAMMA;
+    r->s[0] = splitmix_next(&s);
+    r->s[1] = splitmix_next(&s);
+    r->s[2] = splitmix_next(&s);
+    r->s[3] = splitmix_next(&s);
+}
+
+uint32_t seeded_random_next_int(SeededRandom* r) {
+    uint32_t* s = r->s;
+    uint32_t result = s[0] + s[3];
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+
+    return result;
+}
+
+double seeded_random_next_float(SeededRandom* r) {
+    return (double)seeded_random_next_int(r) / 4294967296.0;
+}
+
+double seeded_random_next_double(SeededRandom* r) {
+    return seeded_random_next_float(r) * 2 - 1;
+}
+
+int seeded_random_next_bounded(SeededRandom* r, int bound) {
+    return (int)floor(seeded_random_next_float(r) * bound);
+}
+
+void seeded_perlin_init(SeededPerlin* p, SeededRandom* r) {
+    for (int i = 0; i < 256; i++) {
+        p->perm[i] = (uint8_t)i;
+    }
+
+    // Shuffle
+    for (int i = 0; i < 256; i++) {
+        int j = seeded_random_next_bounded(r, 256 - i) + i;
+        uint8_t tmp = p->perm[i];
+        p->perm[i] = p->perm[j];
+        p->perm[j] = tmp;
+    }
+
+    // Duplicate for wrapping
+    for (int i = 0; i < 256; i++) {
+        p->perm[i + 256] = p->perm[i];
+    }
+
+    // Random origin offset
+    p->origin_x = seeded_random_next_double(r) * 256;
+    p->origin_y = seeded_random_next_double(r) * 256;
+    p->origin_z = seeded_random_next_double(r) * 256;
+}
+
+static inline double fade(double t) {
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+static inline double lerp(double t, double a, double b) {
+    return a + t * (b - a);
+}
+
+static inline double grad(int hash, double x, double y, double z) {
+    int h = hash & 15;
+    double u = h < 8 ? x : y;
+    double v = h < 4 ? y : (h == 12 || h == 14) ? x : z;
+    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+}
+
+double seeded_perlin_sample(const SeededPerlin* p, double x, double y, double z) {
+    double px = x + p->origin_x;
+    double py = y + p->origin_y;
+    double pz = z + p->origin_z;
+
+    double fx = floor(px);
+    double fy = floor(py);
+    double fz = floor(pz);
+
+    int xi = (int)fx & 255;
+    int yi = (int)fy & 255;
+    int zi = (int)fz & 255;
+
+    double xf = px - fx;
+    double yf = py - fy;
+    double zf = pz - fz;
+
+    double u = fade(xf);
+    double v = fade(yf);
+    double w = fade(zf);
+
+    const uint8_t* perm = p->perm;
+    int a = perm[xi] + yi;
+    int aa = perm[a] + zi;
+    int ab = perm[a + 1] + zi;
+    int b = perm[xi + 1] + yi;
+    int ba = perm[b] + zi;
+    int bb = perm[b + 1] + zi;
+
+    return lerp(
+        w,
+        lerp(
+            v,
+            lerp(u, grad(perm[aa], xf, yf, zf), grad(perm[ba], xf - 1, yf, zf)),
+            lerp(u, grad(perm[ab], xf, yf - 1, zf), grad(perm[bb], xf - 1, yf - 1, zf))
+        ),
+        lerp(
+            v,
+            lerp(u, grad(perm[aa + 1], xf, yf, zf - 1), grad(perm[ba + 1], xf - 1, yf, zf - 1)),
+            lerp(u, grad(perm[ab + 1], xf, yf - 1, zf - 1), grad(perm[bb + 1], xf - 1, yf - 1, zf - 1))
+        )
+    );
+}
+
+#ifdef __wasm_simd128__
+
+/*
+ * simd128 kernels: two cells per op in f64x2 lanes
+ * Lanes stay in double precision (not f32x4) so every cell is bit-identical
+ * to the scalar path and to the JS PerlinNoise.
+ */
+
+static inline v128_t fade_x2(v128_t t) {
+    v128_t t3 = wasm_f64x2_mul(wasm_f64x2_mul(t, t), t);
+    v128_t poly = wasm_f64x2_sub(wasm_f64x2_mul(t, wasm_f64x2_splat(6)), wasm_f64x2_splat(15));
+    poly = wasm_f64x2_add(wasm_f64x2_mul(t, poly), wasm_f64x2_splat(10));
+    return wasm_f64x2_mul(t3, poly);
+}
+
+static inline v128_t lerp_x2(v128_t t, v128_t a, v128_t b) {
+    return wasm_f64x2_add(a, wasm_f64x2_mul(t, wasm_f64x2_sub(b, a)));
+}
+
+static inline int64_t lane_mask(int cond) {
+    return cond ? -1 : 0;
+}
+
+/**
+ * grad() for two hashes at once: branch-free select of u/v, sign flip by xor
+ */
+static inline v128_t grad_x2(int h0, int h1, v128_t x, v128_t y, v128_t z) {
+    h0 &= 15;
+    h1 &= 15;
+    const int64_t sign = (int64_t)0x8000000000000000ULL;
+    
+    v128_t lt8 = wasm_i64x2_make(lane_mask(h0 < 8), lane_mask(h1 < 8));
+    v128_t lt4 = wasm_i64x2_make(lane_mask(h0 < 4), lane_mask(h1 < 4));
+    v128_t use_x = wasm_i64x2_make(lane_mask(h0 == 12 || h0 == 14), lane_mask(h1 == 12 || h1 == 14));
+    
+    v128_t u = wasm_v128_bitselect(x, y, lt8);
+    v128_t v = wasm_v128_bitselect(y, wasm_v128_bitselect(x, z, use_x), lt4);
+    
+    u = wasm_v128_xor(u, wasm_i64x2_make((h0 & 1) ? sign : 0, (h1 & 1) ? sign : 0));
+    v = wasm_v128_xor(v, wasm_i64x2_make((h0 & 2) ? sign : 0, (h1 & 2) ? sign : 0));
+    return wasm_f64x2_add(u, v);
+}
+
+/**
+ * Sample two points that share y and z
+ */
+static inline v128_t perlin_sample_x2(const SeededPerlin* p, v128_t x, double y, double z) {
+    v128_t px = wasm_f64x2_add(x, wasm_f64x2_splat(p->origin_x));
+    double py = y + p->origin_y;
+    double pz = z + p->origin_z;
+    
+    v128_t fx = wasm_f64x2_floor(px);
+    double fy = floor(py);
+    double fz = floor(pz);
+    
+    int yi = (int)fy & 255;
+    int zi = (int)fz & 255;
+    int xi0 = (int)wasm_f64x2_extract_lane(fx, 0) & 255;
+    int xi1 = (int)wasm_f64x2_extract_lane(fx, 1) & 255;
+    
+    v128_t xf = wasm_f64x2_sub(px, fx);
+    v128_t yf = wasm_f64x2_splat(py - fy);
+    v128_t zf = wasm_f64x2_splat(pz - fz);
+    
+    v128_t u = fade_x2(xf);
+    v128_t v = fade_x2(yf);
+    v128_t w = fade_x2(zf);
+    
+    const uint8_t* perm = p->perm;
+    int a0 = perm[xi0] + yi, a1 = perm[xi1] + yi;
+    int aa0 = perm[a0] + zi, aa1 = perm[a1] + zi;
+    int ab0 = perm[a0 + 1] + zi, ab1 = perm[a1 + 1] + zi;
+    int b0 = perm[xi0 + 1] + yi, b1 = perm[xi1 + 1] + yi;
+    int ba0 = perm[b0] + zi, ba1 = perm[b1] + zi;
+    int bb0 = perm[b0 + 1] + zi, bb1 = perm[b1 + 1] + zi;
+    
+    v128_t one = wasm_f64x2_splat(1);
+    v128_t xf1 = wasm_f64x2_sub(xf, one);
+    v128_t yf1 = wasm_f64x2_sub(yf, one);
+    v128_t zf1 = wasm_f64x2_sub(zf, one);
+    
+    return lerp_x2(
+        w,
+        lerp_x2(
+            v,
+            lerp_x2(u, grad_x2(perm[aa0], perm[aa1], xf, yf, zf), grad_x2(perm[ba0], perm[ba1], xf1, yf, zf)),
+            lerp_x2(u, grad_x2(perm[ab0], perm[ab1], xf, yf1, zf), grad_x2(perm[bb0], perm[bb1], xf1, yf1, zf))
+        ),
+        lerp_x2(
+            v,
+            lerp_x2(u, grad_x2(perm[aa0 + 1], perm[aa1 + 1], xf, yf, zf1), grad_x2(perm[ba0 + 1], perm[ba1 + 1], xf1, yf, zf1)),
+            lerp_x2(u, grad_x2(perm[ab0 + 1], perm[ab1 + 1], xf, yf1, zf1), grad_x2(perm[bb0 + 1], perm[bb1 + 1], xf1, yf1, zf1))
+        )
+    );
+}
+
+#endif
+
+void seeded_perlin_sample_grid(const SeededPerlin* p, int x0, int z0, int nx, int nz, double scale, double* out) {
+    for (int j = 0; j < nz; j++) {
+        double z = (z0 + j) * scale;
+        double* row = out + (size_t)j * nx;
+        int i = 0;
+        
+#ifdef __wasm_simd128__
+        for (; i + 1 < nx; i += 2) {
+            v128_t x = wasm_f64x2_make((x0 + i) * scale, (x0 + i + 1) * scale);
+            wasm_v128_store(row + i, perlin_sample_x2(p, x, 0, z));
+        }
+#endif
+        
+        for (; i < nx; i++) {
+            row[i] = seeded_perlin_sample(p, (x0 + i) * scale, 0, z);
+        }
+    }
+}
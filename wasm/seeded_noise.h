@@ -0,0 +1,49 @@
+/**
+ * Seeded noise - C port of SeededRandom and PerlinNoise from src/cubiomes/noise.ts
+ * Bit-exact with the TypeScript versions (same seeding, same double math),
+ * so anything moved from JS into the wrapper produces identical worlds.
+ */
+
+#ifndef SEEDED_NOISE_H
+#define SEEDED_NOISE_H
+
+#include <stdint.h>
+
+/**
+ * SeededRandom (splitmix64-seeded xoshiro128 variant)
+ */
+typedef struct {
+    uint32_t s[4];
+} SeededRandom;
+
+/**
+ * PerlinNoise with a seeded permutation table and origin offset
+ */
+typedef struct {
+    uint8_t perm[512];
+    double origin_x;
+    double origin_y;
+    double origin_z;
+} SeededPerlin;
+
+/**
+ * Seed the generator; seed is the JS number (negative int32 values sign-extend like BigInt)
+ */
+void seeded_random_init(SeededRandom* r, int64_t seed);
+uint32_t seeded_random_next_int(SeededRandom* r);
+double seeded_random_next_float(SeededRandom* r);   // [0, 1)
+double seeded_random_next_double(SeededRandom* r);  // [-1, 1)
+int seeded_random_next_bounded(SeededRandom* r, int bound);  // [0, bound)
+
+void seeded_perlin_init(SeededPerlin* p, SeededRandom* r);
+double seeded_perlin_sample(const SeededPerlin* p, double x, double y, double z);
+
+/**
+ * Sample a grid of 2D noise (y = 0), matching per-cell sample2D(wx * scale, wz * scale)
+ * Vectorized with simd128 when the module is built with -msimd128.
+ * @param x0, z0 - World position of the first cell
+ * @param nx, nz - Grid size; out receives nx * nz values, row-major
+ */
+void seeded_perlin_sample_grid(const SeededPerlin* p, int x0, int z0, int nx, int nz, double scale, double* out);
+
+#endif
@@ -0,0 +1,437 @@
+/**
+ * Tree generation - C port of the Pumpkin-inspired tree generator
+ * (src/world/vegetation/TreeGenerator.ts, ChunkGenerator.generateTrees)
+ * https://github.com/Pumpkin-MC/Pumpkin
+ *
+ * Shapes are built once per (type, variant) into a shared template table;
+ * chunks only pick a variant per tree, so a forest chunk costs a few
+ * records instead of a few thousand blocks.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "seeded_noise.h"
+#include "tree_gen.h"
+
+// Must match SEA_LEVEL and BlockType in src/world/types.ts
+#define TREE_SEA_LEVEL 63
+#define BLOCK_WATER 6
+#define BLOCK_ICE 7
+
+// Trees stay 2 blocks away from the chunk edge
+#define TREE_EDGE 2
+
+// Block deduplication: open-addressed set of positions, per tree
+#define DEDUP_SLOTS 1024
+
+// Template shapes are seeded TREE_TEMPLATE_SEED + type * TREE_VARIANTS + variant
+#define TREE_TEMPLATE_SEED 0x54524545  // "TREE"
+
+// Spacing grid bits: a column within 3 / within 4 blocks of a placed tree
+#define NEAR_3 0x01
+#define NEAR_4 0x02
+
+typedef struct {
+    int base_height;
+    int height_rand_a;
+    int height_rand_b;
+} TrunkConfig;
+
+static const TrunkConfig TRUNK_CONFIGS[TREE_TYPE_COUNT] = {
+    [TREE_OAK]      = { 4, 2, 0 },
+    [TREE_BIRCH]    = { 5, 2, 0 },
+    [TREE_SPRUCE]   = { 5, 2, 3 },
+    [TREE_JUNGLE]   = { 4, 8, 0 },
+    [TREE_ACACIA]   = { 5, 2, 0 },
+    [TREE_DARK_OAK] = { 6, 2, 0 },
+    [TREE_CHERRY]   = { 4, 3, 0 },
+    [TREE_MANGROVE] = { 5, 3, 0 },
+    [TREE_CACTUS]   = { 1, 2, 0 },
+};
+
+/**
+ * Blocks of the tree being built, deduplicated as they are added
+ * Keeps first-placement order, like the Map in deduplicateBlocks.
+ */
+typedef struct {
+    uint32_t* blocks;
+    int count;
+    int overflow;
+    uint32_t keys[DEDUP_SLOTS];      // Position key + 1, 0 = empty
+    uint16_t slots[DEDUP_SLOTS];     // Index into blocks
+} TreeBuilder;
+
+static void builder_init(TreeBuilder* b, uint32_t* blocks) {
+    b->blocks = blocks;
+    b->count = 0;
+    b->overflow = 0;
+    memset(b->keys, 0, sizeof(b->keys));
+}
+
+/**
+ * Add a block; logs and cactus replace leaves at the same position,
+ * anything else keeps the block placed first
+ */
+static void emit(TreeBuilder* b, int dx, int dy, int dz, int kind) {
+    if (!b) return;   // Only replaying the random draws (see tree_gen_chunk)
+
+    uint32_t key = (TREE_BLOCK_PACK(dx, dy, dz, 0) & 0x00FFFFFFu) + 1;
+    uint32_t slot = (key * 2654435761u) >> 22;   // Top 10 bits
+
+    while (b->keys[slot] != 0) {
+        if (b->keys[slot] == key) {
+            if (kind != TREE_BLOCK_LEAVES) {
+                b->blocks[b->slots[slot]] = TREE_BLOCK_PACK(dx, dy, dz, kind);
+            }
+            return;
+        }
+        slot = (slot + 1) & (DEDUP_SLOTS - 1);
+    }
+
+    if (b->count >= MAX_TREE_BLOCKS) {
+        b->overflow = 1;
+        return;
+    }
+    b->keys[slot] = key;
+    b->slots[slot] = (uint16_t)b->count;
+    b->blocks[b->count++] = TREE_BLOCK_PACK(dx, dy, dz, kind);
+}
+
+static int trunk_height(int type, SeededRandom* r) {
+    const TrunkConfig* c = &TRUNK_CONFIGS[type];
+    int a = seeded_random_next_bounded(r, c->height_rand_a + 1);
+    int b = seeded_random_next_bounded(r, c->height_rand_b + 1);
+    return c->base_height + a + b;
+}
+
+// ============ Foliage placers ============
+
+/**
+ * Blob foliage - Oak, Birch, Mangrove (Pumpkin's BlobFoliagePlacer)
+ */
+static void blob_foliage(TreeBuilder* b, int center_y, int foliage_height, int radius, SeededRandom* r) {
+    for (int y = 0; y <= foliage_height; y++) {
+        int layer = radius - y / 2;
+        if (layer < 0) layer = 0;
+
+        for (int dx = -layer; dx <= layer; dx++) {
+            for (int dz = -layer; dz <= layer; dz++) {
+                if (abs(dx) == layer && abs(dz) == layer) {
+                    // The coin is flipped even on the bottom layer
+                    if (seeded_random_next_bounded(r, 2) == 0 || y == 0) continue;
+                }
+                emit(b, dx, center_y - y, dz, TREE_BLOCK_LEAVES);
+            }
+        }
+    }
+}
+
+/**
+ * Spruce foliage - cone with periodic radius resets
+ */
+static void spruce_foliage(TreeBuilder* b, int center_y, int foliage_height, int max_radius, SeededRandom* r) {
+    int radius = seeded_random_next_bounded(r, 2);
+    int max = 1;
+    int next = 0;
+
+    for (int y = 0; y < foliage_height; y++) {
+        for (int dx = -radius; dx <= radius; dx++) {
+            for (int dz = -radius; dz <= radius; dz++) {
+                if (abs(dx) == radius && abs(dz) == radius && radius > 0) continue;
+                emit(b, dx, center_y - y, dz, TREE_BLOCK_LEAVES);
+            }
+        }
+
+        if (radius >= max) {
+            radius = next;
+            next = 1;
+            max = max + 1 < max_radius ? max + 1 : max_radius;
+        } else {
+            radius++;
+        }
+    }
+}
+
+/**
+ * Acacia foliage - small top and a flat, gappy canopy
+ */
+static void acacia_foliage(TreeBuilder* b, int center_y, SeededRandom* r) {
+    int radius = 2 + seeded_random_next_bounded(r, 2);
+
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dz = -1; dz <= 1; dz++) {
+            emit(b, dx, center_y, dz, TREE_BLOCK_LEAVES);
+        }
+    }
+
+    for (int dx = -radius; dx <= radius; dx++) {
+        for (int dz = -radius; dz <= radius; dz++) {
+            if (dx * dx + dz * dz <= radius * radius + 1) {
+                if (seeded_random_next_float(r) > 0.1) {
+                    emit(b, dx, center_y - 1, dz, TREE_BLOCK_LEAVES);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Dark oak foliage - three thick layers, no randomness
+ */
+static void dark_oak_foliage(TreeBuilder* b, int center_y) {
+    for (int y = 0; y < 3; y++) {
+        int radius = y == 1 ? 3 : 2;
+        for (int dx = -radius; dx <= radius; dx++) {
+            for (int dz = -radius; dz <= radius; dz++) {
+                if (abs(dx) == radius && abs(dz) == radius) continue;
+                emit(b, dx, center_y - y, dz, TREE_BLOCK_LEAVES);
+            }
+        }
+    }
+}
+
+/**
+ * Cherry foliage - five overlapping spheres
+ */
+static void cherry_foliage(TreeBuilder* b, int center_y, SeededRandom* r) {
+    static const int clusters[5][3] = {
+        { 0, 0, 0 }, { -2, -1, 0 }, { 2, -1, 0 }, { 0, -1, -2 }, { 0, -1, 2 },
+    };
+    const int cr = 2;
+
+    for (int i = 0; i < 5; i++) {
+        for (int dx = -cr; dx <= cr; dx++) {
+            for (int dz = -cr; dz <= cr; dz++) {
+                for (int dy = -1; dy <= 1; dy++) {
+                    if (dx * dx + dz * dz + dy * dy <= cr * cr + 1) {
+                        if (seeded_random_next_float(r) > 0.15) {
+                            emit(b, clusters[i][0] + dx, center_y + clusters[i][1] + dy,
+                                 clusters[i][2] + dz, TREE_BLOCK_LEAVES);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Jungle foliage - four-layer blob
+ */
+static void jungle_foliage(TreeBuilder* b, int center_y, SeededRandom* r) {
+    const int radius = 3;
+    for (int y = 0; y < 4; y++) {
+        int layer = y == 0 || y == 3 ? radius - 1 : radius;
+
+        for (int dx = -layer; dx <= layer; dx++) {
+            for (int dz = -layer; dz <= layer; dz++) {
+                if (abs(dx) == layer && abs(dz) == layer) {
+                    if (seeded_random_next_bounded(r, 2) == 0) continue;
+                }
+                emit(b, dx, center_y - y, dz, TREE_BLOCK_LEAVES);
+            }
+        }
+    }
+}
+
+/**
+ * Build one tree into b (generateTree)
+ * @param b - Builder, or NULL to only make the random draws building would
+ * @return Trunk height
+ */
+static int build_tree(TreeBuilder* b, int type, SeededRandom* r) {
+    if (type == TREE_CACTUS) {
+        int height = trunk_height(type, r);
+        for (int y = 0; y < height; y++) {
+            emit(b, 0, y, 0, TREE_BLOCK_CACTUS);
+        }
+        return height;
+    }
+
+    int trunk = trunk_height(type, r);
+
+    if (type == TREE_DARK_OAK || type == TREE_JUNGLE) {
+        // 2x2 trunk
+        for (int y = 0; y < trunk; y++) {
+            emit(b, 0, y, 0, TREE_BLOCK_LOG);
+            emit(b, 1, y, 0, TREE_BLOCK_LOG);
+            emit(b, 0, y, 1, TREE_BLOCK_LOG);
+            emit(b, 1, y, 1, TREE_BLOCK_LOG);
+        }
+    } else if (type == TREE_ACACIA) {
+        // Bent trunk
+        for (int y = 0; y < trunk - 2; y++) {
+            emit(b, 0, y, 0, TREE_BLOCK_LOG);
+        }
+        int bend = seeded_random_next_bounded(r, 4);
+        int dx = bend == 0 ? 1 : bend == 1 ? -1 : 0;
+        int dz = bend == 2 ? 1 : bend == 3 ? -1 : 0;
+        emit(b, dx, trunk - 2, dz, TREE_BLOCK_LOG);
+        emit(b, dx * 2, trunk - 1, dz * 2, TREE_BLOCK_LOG);
+    } else {
+        for (int y = 0; y < trunk; y++) {
+            emit(b, 0, y, 0, TREE_BLOCK_LOG);
+        }
+    }
+
+    int foliage_top = trunk + 1;
+
+    switch (type) {
+        case TREE_OAK:
+        case TREE_BIRCH:
+            blob_foliage(b, foliage_top, 3, 2, r);
+            break;
+
+        case TREE_SPRUCE:
+            spruce_foliage(b, foliage_top, trunk - 2 > 4 ? trunk - 2 : 4, 2, r);
+            break;
+
+        case TREE_JUNGLE:
+            jungle_foliage(b, foliage_top, r);
+            break;
+
+        case TREE_ACACIA:
+            acacia_foliage(b, foliage_top - 1, r);
+            break;
+
+        case TREE_DARK_OAK:
+            dark_oak_foliage(b, foliage_top);
+            break;
+
+        case TREE_CHERRY:
+            cherry_foliage(b, foliage_top, r);
+            break;
+
+        case TREE_MANGROVE: {
+            // Prop roots at round(cos/sin(i * 90deg) * 1.5), as in the JS version
+            static const int roots[4][2] = { { 2, 0 }, { 0, 2 }, { -1, 0 }, { 0, -1 } };
+            blob_foliage(b, foliage_top, 4, 3, r);
+            for (int i = 0; i < 4; i++) {
+                emit(b, roots[i][0], 0, roots[i][1], TREE_BLOCK_LOG);
+                emit(b, roots[i][0], 1, roots[i][1], TREE_BLOCK_LOG);
+            }
+            break;
+        }
+    }
+
+    return trunk;
+}
+
+/**
+ * JS ToInt32 of a double holding an integer (as `^` does to its operands)
+ */
+static int32_t js_to_int32(double v) {
+    if (!isfinite(v)) return 0;
+    double m = fmod(trunc(v), 4294967296.0);
+    if (m < 0) m += 4294967296.0;
+    return (int32_t)(uint32_t)m;
+}
+
+/**
+ * Mark the columns a new tree at (x, z) keeps other trees out of
+ */
+static void mark_near(uint8_t* near, int x, int z) {
+    for (int dz = -3; dz <= 3; dz++) {
+        for (int dx = -3; dx <= 3; dx++) {
+            int nx = x + dx, nz = z + dz;
+            if (nx < 0 || nx >= CHUNK_SIZE || nz < 0 || nz >= CHUNK_SIZE) continue;
+
+            int d2 = dx * dx + dz * dz;
+            if (d2 < 16) near[nz * CHUNK_SIZE + nx] |= NEAR_4;
+            if (d2 < 9) near[nz * CHUNK_SIZE + nx] |= NEAR_3;
+        }
+    }
+}
+
+int tree_gen_templates(TreeTemplateTable* out) {
+    TreeBuilder builder;
+    out->block_count = 0;
+
+    for (int type = 0; type < TREE_TYPE_COUNT; type++) {
+        for (int variant = 0; variant < TREE_VARIANTS; variant++) {
+            SeededRandom rng;
+            seeded_random_init(&rng, TREE_TEMPLATE_SEED + type * TREE_VARIANTS + variant);
+
+            builder_init(&builder, out->blocks + out->block_count);
+            int height = build_tree(&builder, type, &rng);
+            if (builder.overflow) return -1;
+
+            out->start[type][variant] = out->block_count;
+            out->count[type][variant] = builder.count;
+            out->height[type][variant] = height;
+            out->block_count += builder.count;
+        }
+    }
+    return out->block_count;
+}
+
+/**
+ * Shape variant of a tree, hashed from its chunk seed and column
+ * Kept off the placement RNG, so picking a shape never moves later trees.
+ */
+static int tree_variant(int32_t chunk_seed, int lx, int lz) {
+    uint32_t h = (uint32_t)chunk_seed ^ (uint32_t)(lz * CHUNK_SIZE + lx) * 0x9E3779B1u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return (int)(h % TREE_VARIANTS);
+}
+
+int tree_gen_chunk(const TreeTable* table, int32_t seed, int cx, int cz,
+                   const ChunkSurface* surface, ChunkTrees* out) {
+    out->tree_count = 0;
+
+    // Chunk RNG: seed ^ (cx * 341873128712 + cz * 132897987541) in double math
+    double mx = (double)cx * 341873128712.0;
+    double mz = (double)cz * 132897987541.0;
+    int32_t chunk_seed = (int32_t)(seed ^ js_to_int32(mx + mz));
+    SeededRandom rng;
+    seeded_random_init(&rng, chunk_seed);
+
+    // Density comes from the center column's biome
+    int target = table->density[surface->biome[(CHUNK_SIZE / 2) * CHUNK_SIZE + CHUNK_SIZE / 2]];
+    if (target > MAX_CHUNK_TREES) target = MAX_CHUNK_TREES;
+    if (target == 0) return 0;
+
+    uint8_t near[CHUNK_SIZE * CHUNK_SIZE];
+    memset(near, 0, sizeof(near));
+
+    int attempts = target * 3;
+    for (int attempt = 0; attempt < attempts && out->tree_count < target; attempt++) {
+        int lx = TREE_EDGE + seeded_random_next_bounded(&rng, CHUNK_SIZE - 2 * TREE_EDGE);
+        int lz = TREE_EDGE + seeded_random_next_bounded(&rng, CHUNK_SIZE - 2 * TREE_EDGE);
+
+        int idx = lz * CHUNK_SIZE + lx;
+        int top = surface->top_block[idx];
+        if (top == BLOCK_WATER || top == BLOCK_ICE) continue;
+        if (surface->height[idx] < TREE_SEA_LEVEL) continue;
+
+        int biome = surface->biome[idx];
+        int type = table->primary[biome];
+        if (type == TREE_NONE) continue;
+        if (table->secondary[biome] != TREE_NONE && !(seeded_random_next_float(&rng) < table->chance[biome])) {
+            type = table->secondary[biome];
+        }
+        if (type >= TREE_TYPE_COUNT) continue;
+
+        // Minimum spacing: 4 for jungle trees, 3 for the rest
+        if (near[idx] & (type == TREE_JUNGLE ? NEAR_4 : NEAR_3)) continue;
+
+        TreeRecord* tree = &out->trees[out->tree_count++];
+        tree->x = lx;
+        tree->z = lz;
+        tree->type = type;
+        tree->variant = tree_variant(chunk_seed, lx, lz);
+
+        // The shape comes from the templates, but the chunk RNG still advances
+        // as if the tree were built here, so later trees keep their positions
+        build_tree(NULL, type, &rng);
+
+        mark_near(near, lx, lz);
+    }
+
+    return out->tree_count;
+}
@@ -0,0 +1,31 @@
+/**
+ * Tree generation - tree placement and shapes, ported from the former
+ * JS generator (src/world/vegetation/TreeGenerator.ts)
+ * Placement is deterministic per seed and chunk; shapes come from a
+ * shared table of pre-built templates.
+ */
+
+#ifndef TREE_GEN_H
+#define TREE_GEN_H
+
+#include <stdint.h>
+#include "cubiomes_wrapper.h"
+
+/**
+ * Build TREE_VARIANTS shapes for every tree type
+ * @return Total number of template blocks, or -1 if a shape overflowed MAX_TREE_BLOCKS
+ */
+int tree_gen_templates(TreeTemplateTable* out);
+
+/**
+ * Place the trees of one chunk
+ * @param table - Per-biome density and tree type rules (see TreeTable)
+ * @param seed - World seed as a JS int32 (ChunkGenerator seed, ToInt32)
+ * @param surface - The chunk's heights, top blocks and biomes
+ * @param out - Receives the trees, as (type, variant) template references
+ * @return Number of trees placed
+ */
+int tree_gen_chunk(const TreeTable* table, int32_t seed, int cx, int cz,
+                   const ChunkSurface* surface, ChunkTrees* out);
+
+#endif
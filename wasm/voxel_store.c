@@ -0,0 +1,379 @@
+/**
+ * Voxel store - per-block world edits (placed and broken blocks)
+ *
+ * Chunks are CHUNK_SIZE x VOXEL_HEIGHT x CHUNK_SIZE, split into 16-high
+ * sections. A section stores a palette of the values it holds and one
+ * bit-packed palette index per cell (1, 2, 4 or 8 bits), so a section
+ * with a handful of edits costs 512 bytes and an unedited one nothing.
+ * Chunks are found through an open-addressed table keyed by (cx, cz).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <emscripten.h>
+#include "cubiomes_wrapper.h"
+
+#define SECTION_HEIGHT 16
+#define SECTION_COUNT (VOXEL_HEIGHT / SECTION_HEIGHT)
+#define SECTION_CELLS (CHUNK_SIZE * SECTION_HEIGHT * CHUNK_SIZE)
+#define SECTION_MAX_BITS 8
+
+#define CHUNK_TABLE_INITIAL 64   // Slots; kept at most half full
+
+/**
+ * One 16-high slice of a chunk
+ * Palette entries are value + 1; entry 0 is always 0 (no edit).
+ * Entries whose cells were all overwritten linger until the next repack.
+ */
+typedef struct {
+    uint8_t palette[1 << SECTION_MAX_BITS];
+    int palette_size;
+    int bits;        // Bits per cell index: 1, 2, 4 or 8
+    int used;        // Cells holding an edit; the section is freed at 0
+    uint32_t* data;  // SECTION_CELLS * bits / 32 words
+} VoxelSection;
+
+typedef struct {
+    VoxelSection* sections[SECTION_COUNT];   // NULL = no edits in the section
+} VoxelChunk;
+
+typedef struct {
+    int32_t cx;
+    int32_t cz;
+    VoxelChunk* chunk;   // NULL = empty slot
+} ChunkSlot;
+
+struct VoxelStore {
+    ChunkSlot* slots;
+    uint32_t capacity;   // Power of two
+    uint32_t count;
+    uint32_t* records;   // voxel_chunk_blocks output: count, then VOXEL_RECORD_PACK records
+};
+
+// ============ Sections ============
+
+static inline int cell_index(int lx, int ly, int lz) {
+    return (ly * CHUNK_SIZE + lz) * CHUNK_SIZE + lx;
+}
+
+static inline int section_read(const VoxelSection* sec, int cell) {
+    int per_word = 32 / sec->bits;
+    uint32_t word = sec->data[cell / per_word];
+    int shift = (cell % per_word) * sec->bits;
+    return (int)((word >> shift) & ((1u << sec->bits) - 1));
+}
+
+static inline void section_write(VoxelSection* sec, int cell, int index) {
+    int per_word = 32 / sec->bits;
+    uint32_t* word = &sec->data[cell / per_word];
+    int shift = (cell % per_word) * sec->bits;
+    uint32_t mask = ((1u << sec->bits) - 1) << shift;
+    *word = (*word & ~mask) | ((uint32_t)index << shift);
+}
+
+static VoxelSection* section_create(void) {
+    VoxelSection* sec = (VoxelSection*)calloc(1, sizeof(VoxelSection));
+    if (!sec) return NULL;
+
+    sec->bits = 1;
+    sec->palette_size = 1;   // palette[0] = 0 (no edit)
+    sec->data = (uint32_t*)calloc(SECTION_CELLS / 32, sizeof(uint32_t));
+    if (!sec->data) {
+        free(sec);
+        return NULL;
+    }
+    return sec;
+}
+
+static void section_destroy(VoxelSection* sec) {
+    if (!sec) return;
+    free(sec->data);
+    free(sec);
+}
+
+/**
+ * Drop unused palette entries and re-pack with room for `extra` more
+ * @return 0 on success, -1 if out of memory (section unchanged)
+ */
+static int section_repack(VoxelSection* sec, int extra) {
+    int counts[1 << SECTION_MAX_BITS] = { 0 };
+    for (int cell = 0; cell < SECTION_CELLS; cell++) {
+        counts[section_read(sec, cell)]++;
+    }
+
+    // Entry 0 stays first; live entries keep their order
+    uint8_t remap[1 << SECTION_MAX_BITS];
+    uint8_t palette[1 << SECTION_MAX_BITS];
+    int size = 0;
+    for (int i = 0; i < sec->palette_size; i++) {
+        if (i == 0 || counts[i] > 0) {
+            remap[i] = (uint8_t)size;
+            palette[size++] = sec->palette[i];
+        }
+    }
+
+    int bits = 1;
+    while ((1 << bits) < size + extra) bits *= 2;
+
+    uint32_t* data = (uint32_t*)calloc(SECTION_CELLS * bits / 32, sizeof(uint32_t));
+    if (!data) return -1;
+
+    VoxelSection packed = *sec;
+    packed.bits = bits;
+    packed.data = data;
+    for (int cell = 0; cell < SECTION_CELLS; cell++) {
+        int index = remap[section_read(sec, cell)];
+        if (index) section_write(&packed, cell, index);
+    }
+
+    free(sec->data);
+    sec->data = data;
+    sec->bits = bits;
+    sec->palette_size = size;
+    memcpy(sec->palette, palette, (size_t)size);
+    return 0;
+}
+
+/**
+ * Palette index of a stored value (value + 1), adding it if needed
+ * @return The index, or -1 if out of memory
+ */
+static int section_palette_index(VoxelSection* sec, uint8_t stored) {
+    for (int i = 0; i < sec->palette_size; i++) {
+        if (sec->palette[i] == stored) return i;
+    }
+    if (sec->palette_size == (1 << sec->bits) && section_repack(sec, 1) < 0) {
+        return -1;
+    }
+    sec->palette[sec->palette_size] = stored;
+    return sec->palette_size++;
+}
+
+// ============ Chunk table ============
+
+static inline uint32_t chunk_hash(int32_t cx, int32_t cz) {
+    uint32_t hash = (uint32_t)cx * 0x9E3779B1u ^ (uint32_t)cz * 0x85EBCA77u;
+    return hash ^ (hash >> 16);
+}
+
+static VoxelChunk* chunk_find(const VoxelStore* s, int32_t cx, int32_t cz) {
+    uint32_t mask = s->capacity - 1;
+    for (uint32_t i = chunk_hash(cx, cz) & mask; s->slots[i].chunk; i = (i + 1) & mask) {
+        if (s->slots[i].cx == cx && s->slots[i].cz == cz) return s->slots[i].chunk;
+    }
+    return NULL;
+}
+
+static void chunk_insert_slot(ChunkSlot* slots, uint32_t capacity, ChunkSlot slot) {
+    uint32_t mask = capacity - 1;
+    uint32_t i = chunk_hash(slot.cx, slot.cz) & mask;
+    while (slots[i].chunk) i = (i + 1) & mask;
+    slots[i] = slot;
+}
+
+/**
+ * Find a chunk, creating it (empty) if it has no edits yet
+ * Chunks are never removed: an emptied chunk is one small struct.
+ */
+static VoxelChunk* chunk_get_or_create(VoxelStore* s, int32_t cx, int32_t cz) {
+    VoxelChunk* chunk = chunk_find(s, cx, cz);
+    if (chunk) return chunk;
+
+    if ((s->count + 1) * 2 > s->capacity) {
+        uint32_t capacity = s->capacity * 2;
+        ChunkSlot* slots = (ChunkSlot*)calloc(capacity, sizeof(ChunkSlot));
+        if (!slots) return NULL;
+        for (uint32_t i = 0; i < s->capacity; i++) {
+            if (s->slots[i].chunk) chunk_insert_slot(slots, capacity, s->slots[i]);
+        }
+        free(s->slots);
+        s->slots = slots;
+        s->capacity = capacity;
+    }
+
+    chunk = (VoxelChunk*)calloc(1, sizeof(VoxelChunk));
+    if (!chunk) return NULL;
+    ChunkSlot slot = { cx, cz, chunk };
+    chunk_insert_slot(s->slots, s->capacity, slot);
+    s->count++;
+    return chunk;
+}
+
+// Arithmetic shift: floor division for negative block coordinates too
+#define CHUNK_OF(v) ((v) >> 4)
+#define LOCAL_OF(v) ((v) & (CHUNK_SIZE - 1))
+
+// ============ Exported API ============
+
+/**
+ * Create an empty voxel store
+ * @return Store handle, or NULL if out of memory
+ */
+EMSCRIPTEN_KEEPALIVE
+VoxelStore* create_voxel_store(void) {
+    VoxelStore* s = (VoxelStore*)calloc(1, sizeof(VoxelStore));
+    if (!s) return NULL;
+
+    s->capacity = CHUNK_TABLE_INITIAL;
+    s->slots = (ChunkSlot*)calloc(s->capacity, sizeof(ChunkSlot));
+    if (!s->slots) {
+        free(s);
+        return NULL;
+    }
+    return s;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void destroy_voxel_store(VoxelStore* s) {
+    if (!s) return;
+
+    for (uint32_t i = 0; i < s->capacity; i++) {
+        VoxelChunk* chunk = s->slots[i].chunk;
+        if (!chunk) continue;
+        for (int sy = 0; sy < SECTION_COUNT; sy++) {
+            section_destroy(chunk->sections[sy]);
+        }
+        free(chunk);
+    }
+    free(s->slots);
+    free(s->records);
+    free(s);
+}
+
+/**
+ * Get the edit at a block
+ * @return The stored value, or VOXEL_NONE if the block was never edited
+ *         (or y is outside 0..VOXEL_HEIGHT-1)
+ */
+EMSCRIPTEN_KEEPALIVE
+int voxel_get(const VoxelStore* s, int x, int y, int z) {
+    if (!s || y < 0 || y >= VOXEL_HEIGHT) return VOXEL_NONE;
+
+    const VoxelChunk* chunk = chunk_find(s, CHUNK_OF(x), CHUNK_OF(z));
+    if (!chunk) return VOXEL_NONE;
+    const VoxelSection* sec = chunk->sections[y / SECTION_HEIGHT];
+    if (!sec) return VOXEL_NONE;
+
+    int index = section_read(sec, cell_index(LOCAL_OF(x), y % SECTION_HEIGHT, LOCAL_OF(z)));
+    return (int)sec->palette[index] - 1;
+}
+
+/**
+ * Record an edit at a block
+ * @param value - 0..VOXEL_MAX_VALUE, or VOXEL_NONE to clear the edit
+ * @return 1 on success, 0 if y or value is out of range or out of memory
+ */
+EMSCRIPTEN_KEEPALIVE
+int voxel_set(VoxelStore* s, int x, int y, int z, int value) {
+    if (!s || y < 0 || y >= VOXEL_HEIGHT) return 0;
+    if (value < VOXEL_NONE || value > VOXEL_MAX_VALUE) return 0;
+
+    VoxelChunk* chunk = value == VOXEL_NONE ? chunk_find(s, CHUNK_OF(x), CHUNK_OF(z))
+                                            : chunk_get_or_create(s, CHUNK_OF(x), CHUNK_OF(z));
+    if (!chunk) return value == VOXEL_NONE;
+
+    VoxelSection** slot = &chunk->sections[y / SECTION_HEIGHT];
+    if (!*slot) {
+        if (value == VOXEL_NONE) return 1;
+        *slot = section_create();
+        if (!*slot) return 0;
+    }
+    VoxelSection* sec = *slot;
+
+    int index = value == VOXEL_NONE ? 0 : section_palette_index(sec, (uint8_t)(value + 1));
+    if (index < 0) return 0;
+
+    int cell = cell_index(LOCAL_OF(x), y % SECTION_HEIGHT, LOCAL_OF(z));
+    int old = section_read(sec, cell);
+    section_write(sec, cell, index);
+    sec->used += (index != 0) - (old != 0);
+
+    if (sec->used == 0) {
+        section_destroy(sec);
+        *slot = NULL;
+    }
+    return 1;
+}
+
+/**
+ * Record the same edit over a box of blocks (bounds inclusive, any order)
+ * y is clipped to 0..VOXEL_HEIGHT-1.
+ * @param value - 0..VOXEL_MAX_VALUE, or VOXEL_NONE to clear the box
+ * @return Number of blocks written, or -1 if value is out of range or out of memory
+ */
+EMSCRIPTEN_KEEPALIVE
+int voxel_fill(VoxelStore* s, int x0, int y0, int z0, int x1, int y1, int z1, int value) {
+    if (!s || value < VOXEL_NONE || value > VOXEL_MAX_VALUE) return -1;
+
+    if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+    if (z0 > z1) { int t = z0; z0 = z1; z1 = t; }
+    if (y0 < 0) y0 = 0;
+    if (y1 >= VOXEL_HEIGHT) y1 = VOXEL_HEIGHT - 1;
+
+    int written = 0;
+    for (int y = y0; y <= y1; y++) {
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) {
+                if (!voxel_set(s, x, y, z, value)) return -1;
+                written++;
+            }
+        }
+    }
+    return written;
+}
+
+/**
+ * Highest edited block of a column
+ * @param ignore - Value to skip (e.g. the broken-block value), or VOXEL_NONE
+ * @return Its y, or VOXEL_NONE if the column has no such edit
+ */
+EMSCRIPTEN_KEEPALIVE
+int voxel_column_top(const VoxelStore* s, int x, int z, int ignore) {
+    if (!s) return VOXEL_NONE;
+
+    const VoxelChunk* chunk = chunk_find(s, CHUNK_OF(x), CHUNK_OF(z));
+    if (!chunk) return VOXEL_NONE;
+
+    for (int sy = SECTION_COUNT - 1; sy >= 0; sy--) {
+        const VoxelSection* sec = chunk->sections[sy];
+        if (!sec) continue;
+        for (int ly = SECTION_HEIGHT - 1; ly >= 0; ly--) {
+            int value = (int)sec->palette[section_read(sec, cell_index(LOCAL_OF(x), ly, LOCAL_OF(z)))] - 1;
+            if (value != VOXEL_NONE && value != ignore) return sy * SECTION_HEIGHT + ly;
+        }
+    }
+    return VOXEL_NONE;
+}
+
+/**
+ * List the edits of one chunk, bottom to top
+ * @param ignore - Value to leave out (e.g. the broken-block value), or VOXEL_NONE
+ * @return Edit count followed by that many VOXEL_RECORD_PACK records
+ *         (valid until the next call), or NULL if out of memory
+ */
+EMSCRIPTEN_KEEPALIVE
+const uint32_t* voxel_chunk_blocks(VoxelStore* s, int cx, int cz, int ignore) {
+    if (!s) return NULL;
+    if (!s->records) {
+        s->records = (uint32_t*)malloc((1 + VOXEL_CHUNK_CELLS) * sizeof(uint32_t));
+        if (!s->records) return NULL;
+    }
+
+    uint32_t count = 0;
+    const VoxelChunk* chunk = chunk_find(s, cx, cz);
+    for (int sy = 0; chunk && sy < SECTION_COUNT; sy++) {
+        const VoxelSection* sec = chunk->sections[sy];
+        if (!sec) continue;
+        for (int cell = 0; cell < SECTION_CELLS; cell++) {
+            int value = (int)sec->palette[section_read(sec, cell)] - 1;
+            if (value == VOXEL_NONE || value == ignore) continue;
+            int lx = cell % CHUNK_SIZE;
+            int lz = (cell / CHUNK_SIZE) % CHUNK_SIZE;
+            int y = sy * SECTION_HEIGHT + cell / (CHUNK_SIZE * CHUNK_SIZE);
+            s->records[1 + count++] = VOXEL_RECORD_PACK(lx, y, lz, value);
+        }
+    }
+    s->records[0] = count;
+    return s->records;
+}